@@ -0,0 +1,650 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Microbenchmarks for every per-frame stage, both for the original OpenCV calls of
+// the vision loop and for their replacements in the template-opencv-core library.
+// Every frame-dependent stage runs on synthetic frames and on frames decoded from a
+// recording (--rec=<file>, by default the bundled reference recording; --rec= skips
+// it) at several resolutions, and with --frames=<dir> also on PNG or JPG snapshots.
+//
+// Run through the bench target, which writes bench-results.json, or directly, e.g.:
+//   template-opencv-bench --rec=CID-140-recording-2020-03-18_144821-selection.rec --benchmark_out=results.json --benchmark_out_format=json
+
+#include "banded-perception.hpp"
+#include "binary-morphology.hpp"
+#include "blob-extraction.hpp"
+#include "cone-classifier.hpp"
+#include "cone-perception.hpp"
+#include "frame-workspace.hpp"
+#include "hsv-threshold.hpp"
+#include "recording-replay.hpp"
+#include "region-of-interest.hpp"
+#include "steering-algorithm.hpp"
+#include "thread-pool.hpp"
+
+#include <benchmark/benchmark.h>
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgcodecs/imgcodecs.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Resolution
+{
+    uint32_t width;
+    uint32_t height;
+};
+
+// The camera delivers 640x480; the others show how the stages scale.
+constexpr Resolution RESOLUTIONS[]{{320, 240}, {640, 480}, {1280, 960}};
+
+constexpr uint32_t SYNTHETIC_FRAMES{8};
+// Every RECORDED_FRAME_STRIDE-th frame of the recording is kept, at most RECORDED_FRAMES,
+// which spreads them over the ~20 s of the reference recording.
+constexpr uint32_t RECORDED_FRAMES{16};
+constexpr uint32_t RECORDED_FRAME_STRIDE{20};
+const std::string DEFAULT_RECORDING{"CID-140-recording-2020-03-18_144821-selection.rec"};
+constexpr size_t STEERING_SAMPLES{4096};
+
+// Frames of one source at one resolution.
+struct FrameSet
+{
+    std::string name;
+    Resolution resolution;
+    std::vector<cv::Mat> frames;
+};
+
+// The cone region of interest, which is given for 640x480, scaled to the resolution.
+RegionOfInterest scaledRegionOfInterest(const Resolution &resolution)
+{
+    const double sx{resolution.width / 640.0};
+    const double sy{resolution.height / 480.0};
+    const RegionOfInterest &roi{CONE_REGION_OF_INTEREST};
+    return clipRegionOfInterest(RegionOfInterest{static_cast<int32_t>(roi.x * sx), static_cast<int32_t>(roi.y * sy), static_cast<int32_t>(roi.width * sx),
+                                                 static_cast<int32_t>(roi.height * sy)},
+                                resolution.width, resolution.height);
+}
+
+// Noisy grey road with a few blue and yellow cones in the region of interest.
+cv::Mat syntheticFrame(const Resolution &resolution, uint32_t seed)
+{
+    std::mt19937 rng{seed};
+    cv::Mat frame(static_cast<int>(resolution.height), static_cast<int>(resolution.width), CV_8UC4);
+    for (int y{0}; y < frame.rows; y++)
+    {
+        uint8_t *row{frame.ptr<uint8_t>(y)};
+        for (int x{0}; x < frame.cols; x++)
+        {
+            const uint8_t grey{static_cast<uint8_t>(90 + rng() % 40)};
+            row[4 * x + 0] = static_cast<uint8_t>(grey + rng() % 8);
+            row[4 * x + 1] = grey;
+            row[4 * x + 2] = static_cast<uint8_t>(grey - rng() % 8);
+            row[4 * x + 3] = 255;
+        }
+    }
+
+    const RegionOfInterest roi{scaledRegionOfInterest(resolution)};
+    const int32_t size{std::max<int32_t>(roi.height / 3, 4)};
+    for (uint32_t cone{0}; cone < 6; cone++)
+    {
+        // Blue cones on the left, yellow ones on the right, as on the track.
+        const bool blue{cone < 3};
+        const cv::Scalar colour{blue ? cv::Scalar(200, 80, 20, 255) : cv::Scalar(20, 200, 230, 255)};
+        const int32_t half{roi.width / 2 - size};
+        const int32_t x{roi.x + (blue ? 0 : roi.width / 2) + static_cast<int32_t>(rng() % static_cast<uint32_t>(std::max(half, 1)))};
+        const int32_t y{roi.y + static_cast<int32_t>(rng() % static_cast<uint32_t>(std::max(roi.height - size, 1)))};
+        cv::rectangle(frame, cv::Rect(x, y, size / 2, size), colour, cv::FILLED);
+    }
+    return frame;
+}
+
+std::vector<FrameSet> syntheticFrameSets()
+{
+    std::vector<FrameSet> sets;
+    for (const auto &resolution : RESOLUTIONS)
+    {
+        FrameSet set{"synthetic", resolution, {}};
+        for (uint32_t i{0}; i < SYNTHETIC_FRAMES; i++)
+        {
+            set.frames.push_back(syntheticFrame(resolution, i + 1));
+        }
+        sets.push_back(set);
+    }
+    return sets;
+}
+
+// One set per resolution, named after the frame source.
+std::vector<FrameSet> emptyFrameSets(const std::string &name)
+{
+    std::vector<FrameSet> sets;
+    for (const auto &resolution : RESOLUTIONS)
+    {
+        sets.push_back(FrameSet{name, resolution, {}});
+    }
+    return sets;
+}
+
+void addFrame(std::vector<FrameSet> &sets, const cv::Mat &bgra)
+{
+    for (auto &set : sets)
+    {
+        cv::Mat resized;
+        cv::resize(bgra, resized, cv::Size(static_cast<int>(set.resolution.width), static_cast<int>(set.resolution.height)));
+        set.frames.push_back(resized);
+    }
+}
+
+// Frames decoded from the opendlv.proxy.ImageReading envelopes of a .rec file, the
+// same way the offline replay and the evaluation runner see them.
+std::vector<FrameSet> recordedFrameSets(const std::string &recording)
+{
+    std::vector<FrameSet> sets{emptyFrameSets("recorded")};
+    RecordingReplay replay{recording};
+    if (!replay.valid())
+    {
+        std::cerr << "Cannot replay " << recording << std::endl;
+        return {};
+    }
+    uint32_t frame{0};
+    replay.frameTrigger([&sets, &frame](const cv::Mat &bgra, int64_t) {
+        if ((0 == frame++ % RECORDED_FRAME_STRIDE) && (sets.front().frames.size() < RECORDED_FRAMES))
+        {
+            addFrame(sets, bgra);
+        }
+    });
+    const ReplayStatistics statistics{replay.run()};
+    if (sets.front().frames.empty())
+    {
+        std::cerr << "None of the " << statistics.frames + statistics.undecodableFrames << " frames of " << recording << " could be decoded" << std::endl;
+        return {};
+    }
+    return sets;
+}
+
+// PNG or JPG snapshots of frames.
+std::vector<FrameSet> snapshotFrameSets(const std::string &directory)
+{
+    std::vector<cv::String> files;
+    std::vector<cv::String> jpegs;
+    cv::glob(directory + "/*.png", files, false);
+    cv::glob(directory + "/*.jpg", jpegs, false);
+    files.insert(files.end(), jpegs.begin(), jpegs.end());
+
+    std::vector<FrameSet> sets{emptyFrameSets("snapshots")};
+    for (const auto &file : files)
+    {
+        const cv::Mat bgr{cv::imread(file, cv::IMREAD_COLOR)};
+        if (bgr.empty())
+        {
+            std::cerr << "Skipping unreadable frame " << file << std::endl;
+            continue;
+        }
+        cv::Mat bgra;
+        cv::cvtColor(bgr, bgra, cv::COLOR_BGR2BGRA);
+        addFrame(sets, bgra);
+    }
+    if (files.empty())
+    {
+        std::cerr << "No .png or .jpg frames found in " << directory << std::endl;
+        sets.clear();
+    }
+    return sets;
+}
+
+std::string benchmarkName(const std::string &stage, const FrameSet &set)
+{
+    return stage + "/" + set.name + "/" + std::to_string(set.resolution.width) + "x" + std::to_string(set.resolution.height);
+}
+
+void countFrames(benchmark::State &state, const Resolution &resolution)
+{
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["pixels"] = static_cast<double>(resolution.width) * resolution.height;
+}
+
+// The four filled black boxes the original loop drew around the region of interest.
+void drawLegacyRectangles(cv::Mat &img, const RegionOfInterest &roi)
+{
+    const int32_t right{img.cols + 10};
+    const int32_t bottom{img.rows + 20};
+    cv::rectangle(img, cv::Point(0, 0), cv::Point(right, roi.y - 1), cv::Scalar(0, 0, 0), cv::FILLED);
+    cv::rectangle(img, cv::Point(0, roi.y + roi.height), cv::Point(right, bottom), cv::Scalar(0, 0, 0), cv::FILLED);
+    cv::rectangle(img, cv::Point(0, 0), cv::Point(roi.x - 1, bottom), cv::Scalar(0, 0, 0), cv::FILLED);
+    cv::rectangle(img, cv::Point(roi.x + roi.width, 0), cv::Point(right, bottom), cv::Scalar(0, 0, 0), cv::FILLED);
+}
+
+// Inputs of the original stages: the masked frames, their HSV images and the thresholded masks.
+struct LegacyInputs
+{
+    std::vector<cv::Mat> masked{};
+    std::vector<cv::Mat> hsv{};
+    std::vector<cv::Mat> blue{};
+    std::vector<cv::Mat> yellow{};
+    std::vector<cv::Mat> blueFiltered{};
+    std::vector<cv::Mat> yellowFiltered{};
+};
+
+const cv::Scalar BLUE_LOWER{78, 50, 50};
+const cv::Scalar BLUE_UPPER{134, 255, 255};
+const cv::Scalar YELLOW_LOWER{9, 0, 147};
+const cv::Scalar YELLOW_UPPER{76, 255, 255};
+
+void legacyMorphology(const cv::Mat &blue, const cv::Mat &yellow, cv::Mat &blueOut, cv::Mat &yellowOut)
+{
+    static const cv::Mat MERGE_BOX{cv::getStructuringElement(cv::MORPH_RECT, cv::Size(5, 5))};
+    static const cv::Mat CLOSE_BOX{cv::getStructuringElement(cv::MORPH_RECT, cv::Size(9, 9))};
+    cv::morphologyEx(blue, blueOut, cv::MORPH_OPEN, MERGE_BOX);
+    cv::morphologyEx(yellow, yellowOut, cv::MORPH_OPEN, MERGE_BOX);
+    cv::morphologyEx(blueOut, blueOut, cv::MORPH_CLOSE, CLOSE_BOX);
+    cv::morphologyEx(yellowOut, yellowOut, cv::MORPH_CLOSE, CLOSE_BOX);
+}
+
+std::shared_ptr<LegacyInputs> legacyInputs(const FrameSet &set)
+{
+    const RegionOfInterest roi{scaledRegionOfInterest(set.resolution)};
+    auto inputs = std::make_shared<LegacyInputs>();
+    for (const auto &frame : set.frames)
+    {
+        cv::Mat masked{frame.clone()};
+        drawLegacyRectangles(masked, roi);
+        cv::Mat hsv;
+        cv::cvtColor(masked, hsv, cv::COLOR_BGR2HSV);
+        cv::Mat blue;
+        cv::Mat yellow;
+        cv::inRange(hsv, BLUE_LOWER, BLUE_UPPER, blue);
+        cv::inRange(hsv, YELLOW_LOWER, YELLOW_UPPER, yellow);
+        cv::Mat blueFiltered;
+        cv::Mat yellowFiltered;
+        legacyMorphology(blue, yellow, blueFiltered, yellowFiltered);
+        inputs->masked.push_back(masked);
+        inputs->hsv.push_back(hsv);
+        inputs->blue.push_back(blue);
+        inputs->yellow.push_back(yellow);
+        inputs->blueFiltered.push_back(blueFiltered);
+        inputs->yellowFiltered.push_back(yellowFiltered);
+    }
+    return inputs;
+}
+
+void registerLegacyStages(const FrameSet &set)
+{
+    const std::shared_ptr<LegacyInputs> inputs{legacyInputs(set)};
+    const std::vector<cv::Mat> frames{set.frames};
+    const Resolution resolution{set.resolution};
+    const RegionOfInterest roi{scaledRegionOfInterest(set.resolution)};
+
+    benchmark::RegisterBenchmark(benchmarkName("legacy/clone", set).c_str(), [frames, resolution](benchmark::State &state) {
+        size_t i{0};
+        for (auto _ : state)
+        {
+            cv::Mat img{frames[i++ % frames.size()].clone()};
+            benchmark::DoNotOptimize(img.data);
+        }
+        countFrames(state, resolution);
+    });
+
+    benchmark::RegisterBenchmark(benchmarkName("legacy/rectangles", set).c_str(), [frames, resolution, roi](benchmark::State &state) {
+        std::vector<cv::Mat> copies;
+        for (const auto &frame : frames)
+        {
+            copies.push_back(frame.clone());
+        }
+        size_t i{0};
+        for (auto _ : state)
+        {
+            drawLegacyRectangles(copies[i++ % copies.size()], roi);
+            benchmark::ClobberMemory();
+        }
+        countFrames(state, resolution);
+    });
+
+    benchmark::RegisterBenchmark(benchmarkName("legacy/cvtColor", set).c_str(), [inputs, resolution](benchmark::State &state) {
+        cv::Mat hsv;
+        size_t i{0};
+        for (auto _ : state)
+        {
+            cv::cvtColor(inputs->masked[i++ % inputs->masked.size()], hsv, cv::COLOR_BGR2HSV);
+            benchmark::DoNotOptimize(hsv.data);
+        }
+        countFrames(state, resolution);
+    });
+
+    benchmark::RegisterBenchmark(benchmarkName("legacy/inRange", set).c_str(), [inputs, resolution](benchmark::State &state) {
+        cv::Mat blue;
+        cv::Mat yellow;
+        size_t i{0};
+        for (auto _ : state)
+        {
+            const cv::Mat &hsv{inputs->hsv[i++ % inputs->hsv.size()]};
+            cv::inRange(hsv, YELLOW_LOWER, YELLOW_UPPER, yellow);
+            cv::inRange(hsv, BLUE_LOWER, BLUE_UPPER, blue);
+            benchmark::DoNotOptimize(blue.data);
+            benchmark::DoNotOptimize(yellow.data);
+        }
+        countFrames(state, resolution);
+    });
+
+    benchmark::RegisterBenchmark(benchmarkName("legacy/morphologyEx", set).c_str(), [inputs, resolution](benchmark::State &state) {
+        cv::Mat blue;
+        cv::Mat yellow;
+        size_t i{0};
+        for (auto _ : state)
+        {
+            const size_t frame{i++ % inputs->blue.size()};
+            legacyMorphology(inputs->blue[frame], inputs->yellow[frame], blue, yellow);
+            benchmark::DoNotOptimize(blue.data);
+            benchmark::DoNotOptimize(yellow.data);
+        }
+        countFrames(state, resolution);
+    });
+
+    benchmark::RegisterBenchmark(benchmarkName("legacy/findContours+moments", set).c_str(), [inputs, resolution](benchmark::State &state) {
+        std::vector<std::vector<cv::Point>> contours;
+        size_t i{0};
+        for (auto _ : state)
+        {
+            const size_t frame{i++ % inputs->blueFiltered.size()};
+            double centroids{0.0};
+            for (const cv::Mat *mask : {&inputs->yellowFiltered[frame], &inputs->blueFiltered[frame]})
+            {
+                cv::findContours(mask->clone(), contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+                for (const auto &contour : contours)
+                {
+                    const cv::Moments moments{cv::moments(contour)};
+                    centroids += moments.m10 / moments.m00 + moments.m01 / moments.m00;
+                }
+            }
+            benchmark::DoNotOptimize(centroids);
+        }
+        countFrames(state, resolution);
+    });
+}
+
+// Workspaces holding the cone masks of every frame, as the library stages expect them.
+std::shared_ptr<std::vector<std::unique_ptr<FrameWorkspace>>> segmentedWorkspaces(const FrameSet &set)
+{
+    const RegionOfInterest roi{scaledRegionOfInterest(set.resolution)};
+    const ConeColourThresholds thresholds{};
+    auto workspaces = std::make_shared<std::vector<std::unique_ptr<FrameWorkspace>>>();
+    for (const auto &frame : set.frames)
+    {
+        workspaces->emplace_back(new FrameWorkspace{set.resolution.width, set.resolution.height, roi});
+        segmentCones(frame, roi, thresholds, nullptr, *workspaces->back());
+        findConeBlobs(*workspaces->back());
+    }
+    return workspaces;
+}
+
+void registerLibraryStages(const FrameSet &set)
+{
+    const std::vector<cv::Mat> frames{set.frames};
+    const Resolution resolution{set.resolution};
+    const RegionOfInterest roi{scaledRegionOfInterest(set.resolution)};
+    const auto workspaces = segmentedWorkspaces(set);
+
+    benchmark::RegisterBenchmark(benchmarkName("acquire/roi-copy", set).c_str(), [frames, resolution, roi](benchmark::State &state) {
+        cv::Mat buffer{cv::Mat::zeros(static_cast<int>(resolution.height), static_cast<int>(resolution.width), CV_8UC4)};
+        const cv::Rect rect(roi.x, roi.y, roi.width, roi.height);
+        cv::Mat destination{buffer(rect)};
+        size_t i{0};
+        for (auto _ : state)
+        {
+            frames[i++ % frames.size()](rect).copyTo(destination);
+            benchmark::ClobberMemory();
+        }
+        countFrames(state, resolution);
+    });
+
+    benchmark::RegisterBenchmark(benchmarkName("segment/hsv", set).c_str(), [frames, resolution, roi](benchmark::State &state) {
+        FrameWorkspace ws{resolution.width, resolution.height, roi};
+        const ConeColourThresholds thresholds{};
+        size_t i{0};
+        for (auto _ : state)
+        {
+            segmentCones(frames[i++ % frames.size()], roi, thresholds, nullptr, ws);
+            benchmark::ClobberMemory();
+        }
+        countFrames(state, resolution);
+    });
+
+    benchmark::RegisterBenchmark(benchmarkName("segment/lut", set).c_str(), [frames, resolution, roi](benchmark::State &state) {
+        FrameWorkspace ws{resolution.width, resolution.height, roi};
+        const ConeColourThresholds thresholds{};
+        const ConeColourClassifier classifier{6, thresholds};
+        size_t i{0};
+        for (auto _ : state)
+        {
+            segmentCones(frames[i++ % frames.size()], roi, thresholds, &classifier, ws);
+            benchmark::ClobberMemory();
+        }
+        countFrames(state, resolution);
+    });
+
+    benchmark::RegisterBenchmark(benchmarkName("morphology/packed", set).c_str(), [workspaces, resolution](benchmark::State &state) {
+        size_t i{0};
+        for (auto _ : state)
+        {
+            FrameWorkspace &ws{*(*workspaces)[i++ % workspaces->size()]};
+            const RegionOfInterest &region{ws.maskRegion};
+            ws.coneMasks.pack(0, ws.blueMask.ptr<uint8_t>(region.y) + region.x, ws.blueMask.step);
+            ws.coneMasks.pack(1, ws.yellowMask.ptr<uint8_t>(region.y) + region.x, ws.yellowMask.step);
+            ws.coneMasks.open(MERGE_RADIUS);
+            ws.coneMasks.close(CLOSE_RADIUS);
+            benchmark::ClobberMemory();
+        }
+        countFrames(state, resolution);
+    });
+
+    benchmark::RegisterBenchmark(benchmarkName("blobs/extract", set).c_str(), [workspaces, resolution](benchmark::State &state) {
+        size_t i{0};
+        for (auto _ : state)
+        {
+            FrameWorkspace &ws{*(*workspaces)[i++ % workspaces->size()]};
+            ws.blobExtractor.extract(ws.coneMasks, 0, ws.maskRegion.x, ws.maskRegion.y, ws.blueBlobs);
+            ws.blobExtractor.extract(ws.coneMasks, 1, ws.maskRegion.x, ws.maskRegion.y, ws.yellowBlobs);
+            benchmark::DoNotOptimize(ws.blueBlobs.data());
+            benchmark::DoNotOptimize(ws.yellowBlobs.data());
+        }
+        countFrames(state, resolution);
+    });
+
+    benchmark::RegisterBenchmark(benchmarkName("frame/serial", set).c_str(), [frames, resolution, roi](benchmark::State &state) {
+        FrameWorkspace ws{resolution.width, resolution.height, roi};
+        const ConeColourThresholds thresholds{};
+        size_t i{0};
+        for (auto _ : state)
+        {
+            segmentCones(frames[i++ % frames.size()], roi, thresholds, nullptr, ws);
+            findConeBlobs(ws);
+            benchmark::DoNotOptimize(steerFromBlobs(ws, YawRateState{0.1, 0.01, 0}));
+        }
+        countFrames(state, resolution);
+    });
+
+    for (const uint32_t bands : {2u, 4u})
+    {
+        benchmark::RegisterBenchmark(benchmarkName("frame/bands-" + std::to_string(bands), set).c_str(), [frames, resolution, roi, bands](benchmark::State &state) {
+            FrameWorkspace ws{resolution.width, resolution.height, roi};
+            ThreadPool pool{bands - 1};
+            BandedPerception banded{pool, bands, ws.maskRegion};
+            const ConeColourThresholds thresholds{};
+            size_t i{0};
+            for (auto _ : state)
+            {
+                banded.segment(frames[i++ % frames.size()], roi, thresholds, nullptr, ws);
+                banded.findBlobs(ws);
+                benchmark::DoNotOptimize(steerFromBlobs(ws, YawRateState{0.1, 0.01, 0}));
+            }
+            countFrames(state, resolution);
+        });
+    }
+}
+
+struct SteeringSamples
+{
+    std::vector<uint8_t> leftCone{};
+    std::vector<uint8_t> rightCone{};
+    std::vector<double> angularVeloZ{};
+    std::vector<double> derivative{};
+};
+
+SteeringSamples steeringSamples()
+{
+    std::mt19937 rng{7};
+    std::uniform_real_distribution<double> yawRate{-60.0, 60.0};
+    SteeringSamples samples;
+    for (size_t i{0}; i < STEERING_SAMPLES; i++)
+    {
+        samples.leftCone.push_back(static_cast<uint8_t>(rng() % 2));
+        samples.rightCone.push_back(static_cast<uint8_t>(rng() % 2));
+        samples.angularVeloZ.push_back(yawRate(rng));
+        samples.derivative.push_back(yawRate(rng) / 4.0);
+    }
+    return samples;
+}
+
+// Stream buffer on a fixed array, so that formatting is measured without I/O or allocations.
+class FixedStreamBuffer : public std::streambuf
+{
+  public:
+    FixedStreamBuffer() noexcept
+    {
+        reset();
+    }
+    void reset() noexcept
+    {
+        setp(m_buffer, m_buffer + sizeof(m_buffer));
+    }
+
+  private:
+    char m_buffer[256]{};
+};
+
+void registerSteeringStages()
+{
+    const auto samples = std::make_shared<SteeringSamples>(steeringSamples());
+
+    benchmark::RegisterBenchmark("steering/checkSteering", [samples](benchmark::State &state) {
+        size_t i{0};
+        for (auto _ : state)
+        {
+            const size_t k{i++ % STEERING_SAMPLES};
+            benchmark::DoNotOptimize(checkSteering(0 != samples->leftCone[k], 0 != samples->rightCone[k], samples->angularVeloZ[k], samples->derivative[k]));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    });
+
+    benchmark::RegisterBenchmark("steering/batch", [samples](benchmark::State &state) {
+        std::vector<double> steering(STEERING_SAMPLES);
+        const SteeringBatch batch{samples->leftCone.data(), samples->rightCone.data(), samples->angularVeloZ.data(), samples->derivative.data(), STEERING_SAMPLES};
+        for (auto _ : state)
+        {
+            checkSteering(batch, steering.data());
+            benchmark::DoNotOptimize(steering.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * STEERING_SAMPLES));
+    });
+
+    benchmark::RegisterBenchmark("output/format", [samples](benchmark::State &state) {
+        FixedStreamBuffer buffer;
+        std::ostream out{&buffer};
+        int64_t sampleTimeStamp{1584542901000000};
+        size_t i{0};
+        for (auto _ : state)
+        {
+            buffer.reset();
+            out << "Group_15;" << sampleTimeStamp++ << ";" << samples->angularVeloZ[i++ % STEERING_SAMPLES] * 0.002879 << std::endl;
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    });
+}
+} // namespace
+
+int32_t main(int32_t argc, char **argv)
+{
+    // Take --rec=<file> and --frames=<dir> out before Google Benchmark sees the arguments.
+    std::string recording{DEFAULT_RECORDING};
+    bool defaultRecording{true};
+    std::string framesDirectory;
+    int32_t kept{1};
+    for (int32_t i{1}; i < argc; i++)
+    {
+        const std::string argument{argv[i]};
+        if (0 == argument.find("--rec="))
+        {
+            recording = argument.substr(std::strlen("--rec="));
+            defaultRecording = false;
+        }
+        else if (0 == argument.find("--frames="))
+        {
+            framesDirectory = argument.substr(std::strlen("--frames="));
+        }
+        else
+        {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    std::vector<FrameSet> sets{syntheticFrameSets()};
+    if (defaultRecording && !std::ifstream(recording).good())
+    {
+        // Outside the source directory, the bundled recording is only found through --rec.
+        std::cerr << "No " << recording << " here; benchmarking without recorded frames" << std::endl;
+    }
+    else if (!recording.empty())
+    {
+        const std::vector<FrameSet> recorded{recordedFrameSets(recording)};
+        if (recorded.empty())
+        {
+            return 1;
+        }
+        sets.insert(sets.end(), recorded.begin(), recorded.end());
+    }
+    if (!framesDirectory.empty())
+    {
+        const std::vector<FrameSet> snapshots{snapshotFrameSets(framesDirectory)};
+        sets.insert(sets.end(), snapshots.begin(), snapshots.end());
+    }
+    for (const auto &set : sets)
+    {
+        registerLegacyStages(set);
+        registerLibraryStages(set);
+    }
+    registerSteeringStages();
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "allocation-counter.hpp"
+
+#include <atomic>
+
+namespace
+{
+std::atomic<bool> g_enabled{false};
+thread_local uint64_t g_allocations{0};
+thread_local uint32_t g_paused{0};
+} // namespace
+
+bool AllocationCounter::enabled() noexcept
+{
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::allocations() noexcept
+{
+    return g_allocations;
+}
+
+void AllocationCounter::count() noexcept
+{
+    if (0 == g_paused)
+    {
+        g_allocations++;
+    }
+    if (!g_enabled.load(std::memory_order_relaxed))
+    {
+        g_enabled.store(true, std::memory_order_relaxed);
+    }
+}
+
+AllocationCounter::Pause::Pause() noexcept
+{
+    g_paused++;
+}
+
+AllocationCounter::Pause::~Pause() noexcept
+{
+    g_paused--;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstdint>
+
+// Counts heap allocations made through operator new on the calling thread. This
+// covers every cv::Mat buffer, too, as OpenCV allocates its UMatData bookkeeping
+// with new. The counting operator new in allocation-counting-new.cpp is only linked
+// into template-opencv when configured with -DCOUNT_ALLOCATIONS=ON; otherwise
+// enabled() is false and all counts stay zero.
+class AllocationCounter
+{
+  public:
+    static bool enabled() noexcept;
+    static uint64_t allocations() noexcept;
+    // Called by the counting operator new for every allocation.
+    static void count() noexcept;
+
+    // Allocations made on the calling thread while a Pause is alive are not counted.
+    class Pause
+    {
+      private:
+        Pause(const Pause &) = delete;
+        Pause(Pause &&) = delete;
+        Pause &operator=(const Pause &) = delete;
+        Pause &operator=(Pause &&) = delete;
+
+      public:
+        Pause() noexcept;
+        ~Pause() noexcept;
+    };
+};
+
+#endif
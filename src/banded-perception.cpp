@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "banded-perception.hpp"
+#include "cone-perception.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+constexpr uint32_t NOT_MERGED{std::numeric_limits<uint32_t>::max()};
+
+// First row of band b when splitting rows into bands of almost equal height.
+uint32_t bandBegin(uint32_t rows, uint32_t bands, uint32_t b) noexcept
+{
+    return static_cast<uint32_t>(static_cast<uint64_t>(rows) * b / bands);
+}
+} // namespace
+
+BandedPerception::Band::Band(uint32_t width, uint32_t rowBegin, uint32_t rowEnd, uint32_t haloBegin, uint32_t haloEnd)
+    : y0{rowBegin}
+    , y1{rowEnd}
+    , haloY0{haloBegin}
+    , haloY1{haloEnd}
+    , masks{width, haloEnd - haloBegin, 2}
+    , extractors{BlobExtractor{width, rowEnd - rowBegin}, BlobExtractor{width, rowEnd - rowBegin}}
+    , blobs{}
+{
+    for (auto &planeBlobs : blobs)
+    {
+        planeBlobs.reserve(BlobExtractor::maximumBlobs(width, y1 - y0));
+    }
+    // Let the morphology size its scratch rows before the first frame.
+    masks.open(MERGE_RADIUS);
+    masks.close(CLOSE_RADIUS);
+}
+
+BandedPerception::BandedPerception(ThreadPool &pool, uint32_t bands, const RegionOfInterest &maskRegion)
+    : m_pool{pool}
+    , m_maskRegion{maskRegion}
+{
+    const uint32_t width{static_cast<uint32_t>(maskRegion.width)};
+    const uint32_t height{static_cast<uint32_t>(maskRegion.height)};
+    // Every band needs at least one row of its own.
+    bands = std::max<uint32_t>(std::min(bands, height), 1);
+    m_bands.reserve(bands);
+    size_t blobs{0};
+    for (uint32_t b{0}; b < bands; b++)
+    {
+        const uint32_t y0{bandBegin(height, bands, b)};
+        const uint32_t y1{bandBegin(height, bands, b + 1)};
+        const uint32_t haloY0{(y0 > HALO_ROWS) ? y0 - HALO_ROWS : 0};
+        const uint32_t haloY1{std::min(y1 + HALO_ROWS, height)};
+        m_bands.emplace_back(width, y0, y1, haloY0, haloY1);
+        blobs += BlobExtractor::maximumBlobs(width, y1 - y0);
+    }
+    m_firstBlob.reserve(bands);
+    m_parent.reserve(blobs);
+    m_mergedIndex.reserve(blobs);
+}
+
+uint32_t BandedPerception::bands() const noexcept
+{
+    return static_cast<uint32_t>(m_bands.size());
+}
+
+void BandedPerception::segment(const cv::Mat &frame, const RegionOfInterest &roi, const ConeColourThresholds &thresholds, const ConeColourClassifier *classifier,
+                               FrameWorkspace &ws)
+{
+    const uint32_t rows{static_cast<uint32_t>(roi.height)};
+    const uint32_t count{bands()};
+    m_pool.run(count, [&](uint32_t b) {
+        const int32_t y0{static_cast<int32_t>(bandBegin(rows, count, b))};
+        const int32_t y1{static_cast<int32_t>(bandBegin(rows, count, b + 1))};
+        if (y0 < y1)
+        {
+            segmentCones(frame, RegionOfInterest{roi.x, roi.y + y0, roi.width, y1 - y0}, thresholds, classifier, ws);
+        }
+    });
+}
+
+void BandedPerception::findBlobs(FrameWorkspace &ws)
+{
+    m_pool.run(bands(), [this, &ws](uint32_t b) { processBand(m_bands[b], ws); });
+    merge(0, ws.blueBlobs);
+    merge(1, ws.yellowBlobs);
+}
+
+void BandedPerception::processBand(Band &band, const FrameWorkspace &ws)
+{
+    // The halo rows of the neighbours are packed and filtered again here; their errors
+    // from the missing rows further out never reach the band's own rows.
+    const int32_t top{m_maskRegion.y + static_cast<int32_t>(band.haloY0)};
+    band.masks.pack(0, ws.blueMask.ptr<uint8_t>(top) + m_maskRegion.x, ws.blueMask.step);
+    band.masks.pack(1, ws.yellowMask.ptr<uint8_t>(top) + m_maskRegion.x, ws.yellowMask.step);
+    band.masks.open(MERGE_RADIUS);
+    band.masks.close(CLOSE_RADIUS);
+
+    for (uint32_t plane{0}; plane < 2; plane++)
+    {
+        band.extractors[plane].extract(band.masks, plane, band.y0 - band.haloY0, band.y1 - band.haloY0, m_maskRegion.x, top, band.blobs[plane]);
+    }
+}
+
+uint32_t BandedPerception::find(uint32_t i) noexcept
+{
+    while (m_parent[i] != i)
+    {
+        m_parent[i] = m_parent[m_parent[i]];
+        i = m_parent[i];
+    }
+    return i;
+}
+
+void BandedPerception::unite(uint32_t a, uint32_t b) noexcept
+{
+    a = find(a);
+    b = find(b);
+    // As in BlobExtractor, the lower index stays the root; band blobs are numbered
+    // band after band in raster order, so the root is the part seen first.
+    if (a < b)
+    {
+        m_parent[b] = a;
+    }
+    else if (b < a)
+    {
+        m_parent[a] = b;
+    }
+}
+
+void BandedPerception::merge(uint32_t plane, std::vector<Blob> &blobs)
+{
+    m_firstBlob.clear();
+    m_parent.clear();
+    for (const auto &band : m_bands)
+    {
+        m_firstBlob.push_back(static_cast<uint32_t>(m_parent.size()));
+        for (size_t i{0}; i < band.blobs[plane].size(); i++)
+        {
+            m_parent.push_back(static_cast<uint32_t>(m_parent.size()));
+        }
+    }
+
+    // Join the blobs whose runs touch across a band edge, diagonals included.
+    for (size_t b{0}; b + 1 < m_bands.size(); b++)
+    {
+        const std::vector<LabelledRun> &above{m_bands[b].extractors[plane].lastRowRuns()};
+        const std::vector<LabelledRun> &below{m_bands[b + 1].extractors[plane].firstRowRuns()};
+        size_t p{0};
+        size_t c{0};
+        while ((p < above.size()) && (c < below.size()))
+        {
+            if (above[p].end < below[c].begin)
+            {
+                p++;
+            }
+            else if (below[c].end < above[p].begin)
+            {
+                c++;
+            }
+            else
+            {
+                unite(m_firstBlob[b] + above[p].blob, m_firstBlob[b + 1] + below[c].blob);
+                if (above[p].end < below[c].end)
+                {
+                    p++;
+                }
+                else
+                {
+                    c++;
+                }
+            }
+        }
+    }
+
+    blobs.clear();
+    m_mergedIndex.assign(m_parent.size(), NOT_MERGED);
+    for (size_t b{0}; b < m_bands.size(); b++)
+    {
+        const std::vector<Blob> &bandBlobs{m_bands[b].blobs[plane]};
+        for (size_t i{0}; i < bandBlobs.size(); i++)
+        {
+            const uint32_t root{find(m_firstBlob[b] + static_cast<uint32_t>(i))};
+            if (NOT_MERGED == m_mergedIndex[root])
+            {
+                m_mergedIndex[root] = static_cast<uint32_t>(blobs.size());
+                blobs.push_back(bandBlobs[i]);
+            }
+            else
+            {
+                blobs[m_mergedIndex[root]].merge(bandBlobs[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BANDED_PERCEPTION_HPP
+#define BANDED_PERCEPTION_HPP
+
+#include "binary-morphology.hpp"
+#include "blob-extraction.hpp"
+#include "cone-classifier.hpp"
+#include "frame-workspace.hpp"
+#include "hsv-threshold.hpp"
+#include "region-of-interest.hpp"
+#include "thread-pool.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Rows every band adds above and below itself so that the opening and the closing
+// near its edges see the same neighbourhood as on the whole mask.
+constexpr uint32_t HALO_ROWS{2 * MERGE_RADIUS + 2 * CLOSE_RADIUS};
+
+// The segmentation, morphology and blob extraction of cone-perception.hpp, with one
+// frame cut into horizontal bands that run as tasks on a thread pool.
+//
+// segment() thresholds the bands of the region of interest straight into the
+// shared byte masks. findBlobs() packs every band of the mask region together with
+// HALO_ROWS of its neighbours into a private PackedMasks, opens and closes it, and
+// extracts the blobs of the band's own rows. Blobs cut by a band edge are then
+// stitched together through the runs of the rows on either side of the edge, so the
+// result equals findConeBlobs() blob for blob and in the same order.
+class BandedPerception
+{
+  private:
+    BandedPerception(const BandedPerception &) = delete;
+    BandedPerception(BandedPerception &&) = delete;
+    BandedPerception &operator=(const BandedPerception &) = delete;
+    BandedPerception &operator=(BandedPerception &&) = delete;
+
+  public:
+    // maskRegion must be the one of the workspaces passed to findBlobs().
+    BandedPerception(ThreadPool &pool, uint32_t bands, const RegionOfInterest &maskRegion);
+
+    uint32_t bands() const noexcept;
+
+    void segment(const cv::Mat &frame, const RegionOfInterest &roi, const ConeColourThresholds &thresholds, const ConeColourClassifier *classifier,
+                 FrameWorkspace &ws);
+    void findBlobs(FrameWorkspace &ws);
+
+  private:
+    struct Band
+    {
+        Band(uint32_t width, uint32_t rowBegin, uint32_t rowEnd, uint32_t haloBegin, uint32_t haloEnd);
+
+        // Own rows [y0, y1) and rows with halo [haloY0, haloY1) of the mask region.
+        uint32_t y0;
+        uint32_t y1;
+        uint32_t haloY0;
+        uint32_t haloY1;
+        PackedMasks masks;
+        BlobExtractor extractors[2];
+        std::vector<Blob> blobs[2];
+    };
+
+    void processBand(Band &band, const FrameWorkspace &ws);
+    void merge(uint32_t plane, std::vector<Blob> &blobs);
+    uint32_t find(uint32_t i) noexcept;
+    void unite(uint32_t a, uint32_t b) noexcept;
+
+  private:
+    ThreadPool &m_pool;
+    const RegionOfInterest m_maskRegion;
+    std::vector<Band> m_bands{};
+    std::vector<uint32_t> m_firstBlob{};
+    std::vector<uint32_t> m_parent{};
+    std::vector<uint32_t> m_mergedIndex{};
+};
+
+#endif
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "binary-morphology.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+struct Or
+{
+    static constexpr uint64_t IDENTITY{0};
+    static uint64_t apply(uint64_t a, uint64_t b) noexcept
+    {
+        return a | b;
+    }
+};
+
+struct And
+{
+    static constexpr uint64_t IDENTITY{~uint64_t{0}};
+    static uint64_t apply(uint64_t a, uint64_t b) noexcept
+    {
+        return a & b;
+    }
+};
+
+constexpr uint64_t Or::IDENTITY;
+constexpr uint64_t And::IDENTITY;
+
+// Combine every pixel of a packed row with its neighbours at distance `shift` (< 64);
+// bits shifted in from outside of the row are 0.
+template <typename Op>
+void shiftRow(uint64_t *words, uint32_t count, uint32_t shift, uint64_t lastWordMask) noexcept
+{
+    uint64_t previous{0};
+    for (uint32_t i{0}; i < count; i++)
+    {
+        const uint64_t current{words[i]};
+        const uint64_t next{(i + 1 < count) ? words[i + 1] : 0};
+        const uint64_t towardsRight{(current << shift) | (previous >> (64 - shift))};
+        const uint64_t towardsLeft{(current >> shift) | (next << (64 - shift))};
+        words[i] = Op::apply(Op::apply(current, towardsRight), towardsLeft);
+        previous = current;
+    }
+    words[count - 1] &= lastWordMask;
+}
+
+// van Herk/Gil-Werman over the extended rows [y0 - radius, y1 + radius): the rows are cut
+// into blocks of k = 2 * radius + 1, running prefix and suffix combinations are built per
+// block, and every output row is suffix[j] op prefix[j + 2 * radius], whatever the radius.
+template <typename Op>
+void verticalPass(const uint64_t *source, uint64_t *destination, uint32_t height, uint32_t stride, uint32_t radius, uint32_t y0, uint32_t y1,
+                  MorphologyScratch &scratch)
+{
+    const uint32_t k{2 * radius + 1};
+    const uint32_t rows{y1 - y0 + 2 * radius};
+    const uint32_t padded{((rows + k - 1) / k) * k};
+    const size_t words{static_cast<size_t>(padded) * stride};
+    if (scratch.prefix.size() < words)
+    {
+        scratch.prefix.resize(words);
+        scratch.suffix.resize(words);
+    }
+    scratch.background.assign(stride, 0);
+    scratch.identity.assign(stride, Op::IDENTITY);
+    uint64_t *prefix{scratch.prefix.data()};
+    uint64_t *suffix{scratch.suffix.data()};
+
+    // Rows above and below the masks are background; rows padding the last block never reach an output.
+    auto extended = [&](uint32_t e) -> const uint64_t * {
+        const int64_t y{static_cast<int64_t>(y0) - radius + e};
+        if (e >= rows)
+        {
+            return scratch.identity.data();
+        }
+        return ((0 <= y) && (y < height)) ? source + static_cast<size_t>(y) * stride : scratch.background.data();
+    };
+
+    for (uint32_t start{0}; start < padded; start += k)
+    {
+        std::copy(extended(start), extended(start) + stride, prefix + static_cast<size_t>(start) * stride);
+        for (uint32_t e{start + 1}; e < start + k; e++)
+        {
+            const uint64_t *before{prefix + static_cast<size_t>(e - 1) * stride};
+            const uint64_t *in{extended(e)};
+            uint64_t *current{prefix + static_cast<size_t>(e) * stride};
+            for (uint32_t w{0}; w < stride; w++)
+            {
+                current[w] = Op::apply(before[w], in[w]);
+            }
+        }
+
+        const uint32_t end{start + k - 1};
+        std::copy(extended(end), extended(end) + stride, suffix + static_cast<size_t>(end) * stride);
+        for (uint32_t e{end}; e-- > start;)
+        {
+            const uint64_t *after{suffix + static_cast<size_t>(e + 1) * stride};
+            const uint64_t *in{extended(e)};
+            uint64_t *current{suffix + static_cast<size_t>(e) * stride};
+            for (uint32_t w{0}; w < stride; w++)
+            {
+                current[w] = Op::apply(after[w], in[w]);
+            }
+        }
+    }
+
+    for (uint32_t j{0}; j < y1 - y0; j++)
+    {
+        const uint64_t *left{suffix + static_cast<size_t>(j) * stride};
+        const uint64_t *right{prefix + static_cast<size_t>(j + 2 * radius) * stride};
+        uint64_t *out{destination + static_cast<size_t>(y0 + j) * stride};
+        for (uint32_t w{0}; w < stride; w++)
+        {
+            out[w] = Op::apply(left[w], right[w]);
+        }
+    }
+}
+
+// Eight bytes of 0x00/0xff for every possible byte of packed pixels.
+struct UnpackTable
+{
+    uint64_t bytes[256];
+    UnpackTable() noexcept
+        : bytes{}
+    {
+        for (uint32_t i{0}; i < 256; i++)
+        {
+            uint64_t v{0};
+            for (uint32_t bit{0}; bit < 8; bit++)
+            {
+                v |= ((i >> bit) & 1) ? (uint64_t{0xff} << (8 * bit)) : 0;
+            }
+            bytes[i] = v;
+        }
+    }
+};
+} // namespace
+
+PackedMasks::PackedMasks(uint32_t width, uint32_t height, uint32_t planes)
+    : m_width{width}
+    , m_height{height}
+    , m_planes{planes}
+    , m_wordsPerRow{std::max<uint32_t>((width + 63) / 64, 1)}
+    , m_stride{m_wordsPerRow * planes}
+    , m_lastWordMask{(0 == width % 64) ? ~uint64_t{0} : ((uint64_t{1} << (width % 64)) - 1)}
+    , m_words(static_cast<size_t>(m_stride) * height, 0)
+    , m_back(static_cast<size_t>(m_stride) * height, 0)
+{
+}
+
+uint32_t PackedMasks::width() const noexcept
+{
+    return m_width;
+}
+
+uint32_t PackedMasks::height() const noexcept
+{
+    return m_height;
+}
+
+uint32_t PackedMasks::planes() const noexcept
+{
+    return m_planes;
+}
+
+uint32_t PackedMasks::wordsPerRow() const noexcept
+{
+    return m_wordsPerRow;
+}
+
+uint32_t PackedMasks::stride() const noexcept
+{
+    return m_stride;
+}
+
+uint64_t *PackedMasks::row(uint32_t plane, uint32_t y) noexcept
+{
+    return m_words.data() + static_cast<size_t>(y) * m_stride + static_cast<size_t>(plane) * m_wordsPerRow;
+}
+
+const uint64_t *PackedMasks::row(uint32_t plane, uint32_t y) const noexcept
+{
+    return m_words.data() + static_cast<size_t>(y) * m_stride + static_cast<size_t>(plane) * m_wordsPerRow;
+}
+
+void PackedMasks::pack(uint32_t plane, const uint8_t *mask, size_t maskStride) noexcept
+{
+    for (uint32_t y{0}; y < m_height; y++)
+    {
+        const uint8_t *bytes{mask + y * maskStride};
+        uint64_t *words{row(plane, y)};
+        for (uint32_t w{0}; w < m_wordsPerRow; w++)
+        {
+            const uint32_t begin{64 * w};
+            const uint32_t end{std::min(begin + 64, m_width)};
+            uint64_t bits{0};
+            uint32_t x{begin};
+#if defined(__SSE2__)
+            const __m128i zero{_mm_setzero_si128()};
+            for (; x + 16 <= end; x += 16)
+            {
+                const __m128i chunk{_mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + x))};
+                const uint32_t background{static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero)))};
+                bits |= static_cast<uint64_t>(~background & 0xffffu) << (x - begin);
+            }
+#endif
+            for (; x < end; x++)
+            {
+                bits |= static_cast<uint64_t>(0 != bytes[x]) << (x - begin);
+            }
+            words[w] = bits;
+        }
+    }
+}
+
+void PackedMasks::unpack(uint32_t plane, uint8_t *mask, size_t maskStride) const noexcept
+{
+    static const UnpackTable TABLE;
+    for (uint32_t y{0}; y < m_height; y++)
+    {
+        uint8_t *bytes{mask + y * maskStride};
+        const uint64_t *words{row(plane, y)};
+        uint32_t x{0};
+        for (; x + 8 <= m_width; x += 8)
+        {
+            const uint64_t pattern{TABLE.bytes[(words[x / 64] >> (x % 64)) & 0xff]};
+            std::memcpy(bytes + x, &pattern, sizeof(pattern));
+        }
+        for (; x < m_width; x++)
+        {
+            bytes[x] = ((words[x / 64] >> (x % 64)) & 1) ? 255 : 0;
+        }
+    }
+}
+
+void PackedMasks::horizontal(bool dilation, uint32_t radius, uint32_t y0, uint32_t y1) noexcept
+{
+    // Growing or shrinking by a then b equals growing or shrinking by a + b, so the
+    // radius is covered with doubling shifts: 1, 2, 4, ... plus what is left.
+    for (uint32_t y{y0}; y < y1; y++)
+    {
+        for (uint32_t plane{0}; plane < m_planes; plane++)
+        {
+            uint64_t *words{row(plane, y)};
+            uint32_t remaining{radius};
+            uint32_t step{1};
+            while (remaining > 0)
+            {
+                const uint32_t shift{std::min(step, remaining)};
+                if (dilation)
+                {
+                    shiftRow<Or>(words, m_wordsPerRow, shift, m_lastWordMask);
+                }
+                else
+                {
+                    shiftRow<And>(words, m_wordsPerRow, shift, m_lastWordMask);
+                }
+                remaining -= shift;
+                step = std::min<uint32_t>(2 * step, 32);
+            }
+        }
+    }
+}
+
+void PackedMasks::vertical(bool dilation, uint32_t radius, uint32_t y0, uint32_t y1, MorphologyScratch &scratch)
+{
+    if (0 == radius)
+    {
+        std::copy(m_words.begin() + static_cast<std::ptrdiff_t>(y0) * m_stride, m_words.begin() + static_cast<std::ptrdiff_t>(y1) * m_stride,
+                  m_back.begin() + static_cast<std::ptrdiff_t>(y0) * m_stride);
+    }
+    else if (dilation)
+    {
+        verticalPass<Or>(m_words.data(), m_back.data(), m_height, m_stride, radius, y0, y1, scratch);
+    }
+    else
+    {
+        verticalPass<And>(m_words.data(), m_back.data(), m_height, m_stride, radius, y0, y1, scratch);
+    }
+}
+
+void PackedMasks::swap() noexcept
+{
+    m_words.swap(m_back);
+}
+
+void PackedMasks::erode(uint32_t radius)
+{
+    horizontal(false, radius, 0, m_height);
+    vertical(false, radius, 0, m_height, m_scratch);
+    swap();
+}
+
+void PackedMasks::dilate(uint32_t radius)
+{
+    horizontal(true, radius, 0, m_height);
+    vertical(true, radius, 0, m_height, m_scratch);
+    swap();
+}
+
+void PackedMasks::open(uint32_t radius)
+{
+    erode(radius);
+    dilate(radius);
+}
+
+void PackedMasks::close(uint32_t radius)
+{
+    dilate(radius);
+    erode(radius);
+}
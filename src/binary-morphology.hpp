@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINARY_MORPHOLOGY_HPP
+#define BINARY_MORPHOLOGY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Scratch rows for the van Herk/Gil-Werman vertical pass; one per thread working on the masks.
+class MorphologyScratch
+{
+  public:
+    std::vector<uint64_t> prefix{};
+    std::vector<uint64_t> suffix{};
+    std::vector<uint64_t> background{};
+    std::vector<uint64_t> identity{};
+};
+
+// Several equally sized binary masks packed 64 pixels per word (bit i of word w is
+// pixel x = 64 * w + i). Every buffer row holds the same row of all planes side by
+// side, so the vertical passes treat the blue and the yellow mask as one wide image
+// and only the horizontal passes look at plane boundaries.
+//
+// Erosion and dilation use a (2 * radius + 1)^2 rectangle, split into a horizontal
+// pass of shifted ORs/ANDs on the packed words and a vertical van Herk/Gil-Werman
+// pass whose cost does not depend on the radius. Pixels outside of the masks count
+// as 0, which matches OpenCV on a black surrounding when the masks carry a margin of
+// at least the largest radius around the region that can hold foreground.
+class PackedMasks
+{
+  private:
+    PackedMasks(const PackedMasks &) = delete;
+    PackedMasks &operator=(const PackedMasks &) = delete;
+
+  public:
+    PackedMasks(uint32_t width, uint32_t height, uint32_t planes);
+    PackedMasks(PackedMasks &&) = default;
+    PackedMasks &operator=(PackedMasks &&) = default;
+
+    uint32_t width() const noexcept;
+    uint32_t height() const noexcept;
+    uint32_t planes() const noexcept;
+    // Words per row of a single plane and per buffer row of all planes.
+    uint32_t wordsPerRow() const noexcept;
+    uint32_t stride() const noexcept;
+
+    uint64_t *row(uint32_t plane, uint32_t y) noexcept;
+    const uint64_t *row(uint32_t plane, uint32_t y) const noexcept;
+
+    // Set every pixel of plane from a byte mask (non-zero is foreground) of width() x height().
+    void pack(uint32_t plane, const uint8_t *mask, size_t maskStride) noexcept;
+    // Write plane as 0/255 bytes into a mask of width() x height().
+    void unpack(uint32_t plane, uint8_t *mask, size_t maskStride) const noexcept;
+
+    void erode(uint32_t radius);
+    void dilate(uint32_t radius);
+    // Erosion followed by dilation removes specks smaller than the rectangle.
+    void open(uint32_t radius);
+    // Dilation followed by erosion merges blobs closer than the rectangle.
+    void close(uint32_t radius);
+
+    // Building blocks for working on horizontal bands in parallel: horizontal()
+    // works in place on rows [y0, y1); vertical() reads rows [y0 - radius, y1 + radius)
+    // and writes rows [y0, y1) of the back buffer, which swap() then makes current.
+    void horizontal(bool dilation, uint32_t radius, uint32_t y0, uint32_t y1) noexcept;
+    void vertical(bool dilation, uint32_t radius, uint32_t y0, uint32_t y1, MorphologyScratch &scratch);
+    void swap() noexcept;
+
+  private:
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_planes;
+    uint32_t m_wordsPerRow;
+    uint32_t m_stride;
+    uint64_t m_lastWordMask;
+    std::vector<uint64_t> m_words;
+    std::vector<uint64_t> m_back;
+    MorphologyScratch m_scratch{};
+};
+
+#endif
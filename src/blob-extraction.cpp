@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "blob-extraction.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+constexpr uint32_t NO_BLOB{std::numeric_limits<uint32_t>::max()};
+
+inline uint32_t countTrailingZeros(uint64_t v) noexcept
+{
+    return static_cast<uint32_t>(__builtin_ctzll(v));
+}
+} // namespace
+
+BlobExtractor::BlobExtractor(uint32_t width, uint32_t height)
+{
+    // A row holds at most one run for every other pixel.
+    const size_t runs{static_cast<size_t>((width + 1) / 2) * height};
+    m_runs.reserve(runs);
+    m_parent.reserve(runs);
+    m_blobIndex.reserve(runs);
+    m_firstRowRuns.reserve((width + 1) / 2);
+    m_lastRowRuns.reserve((width + 1) / 2);
+}
+
+size_t BlobExtractor::maximumBlobs(uint32_t width, uint32_t height) noexcept
+{
+    // 8-connected components need a background pixel between them in both directions.
+    return static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+}
+
+uint32_t BlobExtractor::find(uint32_t i) noexcept
+{
+    while (m_parent[i] != i)
+    {
+        m_parent[i] = m_parent[m_parent[i]];
+        i = m_parent[i];
+    }
+    return i;
+}
+
+void BlobExtractor::unite(uint32_t a, uint32_t b) noexcept
+{
+    a = find(a);
+    b = find(b);
+    // The run found first in raster order stays the root.
+    if (a < b)
+    {
+        m_parent[b] = a;
+    }
+    else if (b < a)
+    {
+        m_parent[a] = b;
+    }
+}
+
+const std::vector<LabelledRun> &BlobExtractor::firstRowRuns() const noexcept
+{
+    return m_firstRowRuns;
+}
+
+const std::vector<LabelledRun> &BlobExtractor::lastRowRuns() const noexcept
+{
+    return m_lastRowRuns;
+}
+
+void BlobExtractor::extract(const PackedMasks &masks, uint32_t plane, int32_t offsetX, int32_t offsetY, std::vector<Blob> &blobs)
+{
+    extract(masks, plane, 0, masks.height(), offsetX, offsetY, blobs);
+}
+
+void BlobExtractor::extract(const PackedMasks &masks, uint32_t plane, uint32_t y0, uint32_t y1, int32_t offsetX, int32_t offsetY, std::vector<Blob> &blobs)
+{
+    m_runs.clear();
+    m_parent.clear();
+    blobs.clear();
+
+    const int32_t width{static_cast<int32_t>(masks.width())};
+    const uint32_t words{masks.wordsPerRow()};
+    uint32_t previousBegin{0};
+    uint32_t previousEnd{0};
+    for (uint32_t y{y0}; y < y1; y++)
+    {
+        // Collect the runs of this row from the packed words; a run may span several words.
+        const uint32_t currentBegin{static_cast<uint32_t>(m_runs.size())};
+        const uint64_t *row{masks.row(plane, y)};
+        bool inside{false};
+        int32_t begin{0};
+        for (uint32_t w{0}; w < words; w++)
+        {
+            const uint64_t bits{row[w]};
+            const int32_t base{static_cast<int32_t>(64 * w)};
+            uint32_t position{0};
+            while (position < 64)
+            {
+                // Look for the next set bit outside of a run, the next clear bit inside of one.
+                const uint64_t rest{(inside ? ~bits : bits) >> position};
+                if (0 == rest)
+                {
+                    break;
+                }
+                position += countTrailingZeros(rest);
+                if (inside)
+                {
+                    m_runs.push_back(Run{static_cast<int32_t>(y), begin, base + static_cast<int32_t>(position)});
+                }
+                else
+                {
+                    begin = base + static_cast<int32_t>(position);
+                }
+                inside = !inside;
+            }
+        }
+        if (inside)
+        {
+            m_runs.push_back(Run{static_cast<int32_t>(y), begin, width});
+        }
+        const uint32_t currentEnd{static_cast<uint32_t>(m_runs.size())};
+        for (uint32_t i{currentBegin}; i < currentEnd; i++)
+        {
+            m_parent.push_back(i);
+        }
+
+        // Merge with runs of the previous row that touch, diagonals included.
+        uint32_t p{previousBegin};
+        for (uint32_t c{currentBegin}; (c < currentEnd) && (p < previousEnd);)
+        {
+            const Run &above{m_runs[p]};
+            const Run &here{m_runs[c]};
+            if (above.end < here.begin)
+            {
+                p++;
+            }
+            else if (here.end < above.begin)
+            {
+                c++;
+            }
+            else
+            {
+                unite(p, c);
+                // Keep the run reaching further right; it may touch the next one of the other row.
+                if (above.end < here.end)
+                {
+                    p++;
+                }
+                else
+                {
+                    c++;
+                }
+            }
+        }
+        previousBegin = currentBegin;
+        previousEnd = currentEnd;
+    }
+
+    // Accumulate moments and bounding boxes per component root.
+    m_blobIndex.assign(m_runs.size(), NO_BLOB);
+    for (uint32_t i{0}; i < m_runs.size(); i++)
+    {
+        const uint32_t root{find(i)};
+        if (NO_BLOB == m_blobIndex[root])
+        {
+            m_blobIndex[root] = static_cast<uint32_t>(blobs.size());
+            blobs.push_back(Blob{0, 0, 0, std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min(),
+                                 std::numeric_limits<int32_t>::min()});
+        }
+        const Run &run{m_runs[i]};
+        Blob &blob{blobs[m_blobIndex[root]]};
+        const int32_t x0{offsetX + run.begin};
+        const int32_t x1{offsetX + run.end - 1};
+        const int32_t y{offsetY + run.y};
+        const uint32_t length{static_cast<uint32_t>(run.end - run.begin)};
+        blob.area += length;
+        blob.sumX += static_cast<uint64_t>(x0 + x1) * length / 2;
+        blob.sumY += static_cast<uint64_t>(y) * length;
+        blob.left = std::min(blob.left, x0);
+        blob.right = std::max(blob.right, x1);
+        blob.top = std::min(blob.top, y);
+        blob.bottom = std::max(blob.bottom, y);
+    }
+
+    m_firstRowRuns.clear();
+    m_lastRowRuns.clear();
+    for (uint32_t i{0}; i < m_runs.size(); i++)
+    {
+        const Run &run{m_runs[i]};
+        const LabelledRun labelled{run.begin, run.end, m_blobIndex[find(i)]};
+        if (static_cast<int32_t>(y0) == run.y)
+        {
+            m_firstRowRuns.push_back(labelled);
+        }
+        if (static_cast<int32_t>(y1) - 1 == run.y)
+        {
+            m_lastRowRuns.push_back(labelled);
+        }
+    }
+}
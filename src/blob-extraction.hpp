@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BLOB_EXTRACTION_HPP
+#define BLOB_EXTRACTION_HPP
+
+#include "binary-morphology.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Moments and bounding box of one 8-connected component, in frame coordinates.
+struct Blob
+{
+    uint32_t area;   // m00
+    uint64_t sumX;   // m10
+    uint64_t sumY;   // m01
+    int32_t left;    // Inclusive bounding box.
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+
+    double centroidX() const noexcept
+    {
+        return static_cast<double>(sumX) / area;
+    }
+    double centroidY() const noexcept
+    {
+        return static_cast<double>(sumY) / area;
+    }
+    // Add the pixels of another part of the same component.
+    void merge(const Blob &other) noexcept
+    {
+        area += other.area;
+        sumX += other.sumX;
+        sumY += other.sumY;
+        left = (other.left < left) ? other.left : left;
+        top = (other.top < top) ? other.top : top;
+        right = (other.right > right) ? other.right : right;
+        bottom = (other.bottom > bottom) ? other.bottom : bottom;
+    }
+};
+
+// A run of foreground pixels [begin, end) in mask coordinates and the index of its blob.
+struct LabelledRun
+{
+    int32_t begin;
+    int32_t end;
+    uint32_t blob;
+};
+
+// Single-pass connected-component labelling on bit-packed masks: runs of foreground
+// pixels are read from the packed words, runs touching runs of the previous row
+// (8-connectivity) are merged with union-find, and area, first-order moments and
+// bounding box are accumulated per component. No contour points are built. All
+// buffers are sized for the worst case up front, so extraction never allocates.
+class BlobExtractor
+{
+  private:
+    BlobExtractor(const BlobExtractor &) = delete;
+    BlobExtractor &operator=(const BlobExtractor &) = delete;
+
+  public:
+    BlobExtractor(uint32_t width, uint32_t height);
+    BlobExtractor(BlobExtractor &&) = default;
+    BlobExtractor &operator=(BlobExtractor &&) = default;
+
+    // Replace blobs by the components of one plane of masks; (offsetX, offsetY) is the
+    // frame position of the masks' top-left pixel. Blobs are ordered by their first
+    // pixel in raster order. blobs should have maximumBlobs() capacity to never grow.
+    void extract(const PackedMasks &masks, uint32_t plane, int32_t offsetX, int32_t offsetY, std::vector<Blob> &blobs);
+    // The same for rows [y0, y1) of masks only; the extractor must have been sized for y1 - y0 rows.
+    void extract(const PackedMasks &masks, uint32_t plane, uint32_t y0, uint32_t y1, int32_t offsetX, int32_t offsetY, std::vector<Blob> &blobs);
+
+    // Runs of the first and the last row of the previous extraction, for stitching
+    // blobs of neighbouring bands together.
+    const std::vector<LabelledRun> &firstRowRuns() const noexcept;
+    const std::vector<LabelledRun> &lastRowRuns() const noexcept;
+
+    // Largest number of blobs a mask of the given size can hold.
+    static size_t maximumBlobs(uint32_t width, uint32_t height) noexcept;
+
+  private:
+    struct Run
+    {
+        int32_t y;
+        int32_t begin; // Inclusive.
+        int32_t end;   // Exclusive.
+    };
+
+    uint32_t find(uint32_t i) noexcept;
+    void unite(uint32_t a, uint32_t b) noexcept;
+
+  private:
+    std::vector<Run> m_runs{};
+    std::vector<uint32_t> m_parent{};
+    std::vector<uint32_t> m_blobIndex{};
+    std::vector<LabelledRun> m_firstRowRuns{};
+    std::vector<LabelledRun> m_lastRowRuns{};
+};
+
+#endif
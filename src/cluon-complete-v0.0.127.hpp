@@ -6413,6 +6413,12 @@ activated and concurrently waiting for data in a separate thread. To check
 whether the instance was created successfully and running, the method
 `isRunning()` should be called.
 
+On Linux, up to 16 datagrams are received per system call (recvmmsg) and
+time stamped by the kernel (SO_TIMESTAMPNS). Setting the environment variable
+`CLUON_UDPRECEIVER_BUSY_POLL` to a number of microseconds lets the receiving
+thread poll the socket without sleeping and enables SO_BUSY_POLL for it, which
+trades one CPU core for lower latency.
+
 A complete example is available
 [here](https://github.com/chrberger/libcluon/blob/master/libcluon/examples/cluon-UDPReceiver.cpp).
 */
@@ -6431,11 +6437,13 @@ class LIBCLUON_API UDPReceiver {
      * @param receiveFromPort Port to receive UDP packets from.
      * @param delegate Functional (noexcept) to handle received bytes; parameters are received data, sender, timestamp.
      * @param localSendFromPort Port that an application is using to send data. This port (> 0) is ignored when data is received.
+     * @param withSender If false, the sender is not transformed to X.Y.Z.W:ABCD and the delegate receives an empty string instead.
      */
     UDPReceiver(const std::string &receiveFromAddress,
                 uint16_t receiveFromPort,
                 std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point &&)> delegate,
-                uint16_t localSendFromPort = 0) noexcept;
+                uint16_t localSendFromPort = 0,
+                bool withSender            = true) noexcept;
     ~UDPReceiver() noexcept;
 
     /**
@@ -6452,12 +6460,44 @@ class LIBCLUON_API UDPReceiver {
     void closeSocket(int errorCode) noexcept;
 
     void readFromSocket() noexcept;
+#ifdef __linux__
+    /**
+     * This method receives batches of datagrams with recvmmsg, waiting for them with epoll.
+     *
+     * @return false if epoll is not available; nothing has been received then.
+     */
+    bool readFromSocketBatched() noexcept;
+
+    // Room for the control message that carries the kernel time stamp of a datagram.
+    union ControlMessage {
+        struct cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(struct timespec))];
+    };
+
+    /**
+     * This method extracts the kernel time stamp (SO_TIMESTAMPNS) from the
+     * control messages of a received datagram.
+     *
+     * @return false if the datagram has none.
+     */
+    bool kernelTimeStamp(struct msghdr &message, std::chrono::system_clock::time_point &timestamp) const noexcept;
+#endif
+
+    /**
+     * This method queues received bytes for the delegate unless we sent them ourselves.
+     *
+     * @return true if the bytes were queued.
+     */
+    bool addToPipeline(const char *data, std::size_t length, const struct sockaddr_in &from, const std::chrono::system_clock::time_point &timestamp) noexcept;
 
    private:
     int32_t m_socket{-1};
     bool m_isBlockingSocket{true};
+    bool m_hasKernelTimeStamps{false};
+    uint32_t m_busyPollInMicroseconds{0};
     std::set<unsigned long> m_listOfLocalIPAddresses{};
     uint16_t m_localSendFromPort;
+    bool m_withSender;
     struct sockaddr_in m_receiveFromAddress {};
     struct ip_mreq m_mreq {};
     bool m_isMulticast{false};
@@ -6472,7 +6512,8 @@ class LIBCLUON_API UDPReceiver {
     class PipelineEntry {
        public:
         std::string m_data;
-        std::string m_from;
+        // Sender; only transformed to X.Y.Z.W:ABCD when handed to the delegate.
+        struct sockaddr_in m_from;
         std::chrono::system_clock::time_point m_sampleTime;
     };
 
@@ -6956,9 +6997,8 @@ class LIBCLUON_API FromProtoVisitor {
         (void)name;
 
         if (m_callToDecodeFromWithDirectVisit) {
-            std::stringstream sstr{std::move(std::string(m_stringValue.data(), static_cast<std::size_t>(m_value)))};
             cluon::FromProtoVisitor nestedProtoDecoder;
-            nestedProtoDecoder.decodeFrom(sstr, v);
+            nestedProtoDecoder.decodeFrom(m_lengthDelimitedValue, static_cast<std::size_t>(m_value), v);
         }
         else if (0 < m_mapOfKeyValues.count(id)) {
             try {
@@ -7017,6 +7057,7 @@ class LIBCLUON_API FromProtoVisitor {
                             m_stringValue.reserve(BYTES_TO_READ_FROM_STREAM);
                         }
                         readBytesFromStream(in, BYTES_TO_READ_FROM_STREAM, m_stringValue.data());
+                        m_lengthDelimitedValue = m_stringValue.data();
                         v.accept(m_fieldId, *this);
                     }
                     break;
@@ -7026,6 +7067,73 @@ class LIBCLUON_API FromProtoVisitor {
         m_callToDecodeFromWithDirectVisit = false;
     }
 
+    /**
+     * This method decodes the Proto-encoded bytes [data, data + size) into
+     * corresponding fields of v. The bytes are read in place: neither a stream
+     * nor a map of intermediate values is used; length-delimited fields are
+     * only copied when they are assigned to a std::string of v. Decoding
+     * stops at the first incomplete field.
+     *
+     * @param data Bytes to decode.
+     * @param size Number of bytes to decode.
+     * @param v Data structure to receive the decoded values.
+     */
+    template<typename T>
+    void decodeFrom(const char *data, std::size_t size, T &v) noexcept {
+        if (nullptr == data) {
+            return;
+        }
+        m_callToDecodeFromWithDirectVisit = true;
+        const char *end{data + size};
+        while ((data < end) && (0 < fromVarInt(data, end, m_keyFieldType))) {
+            m_protoType = static_cast<ProtoConstants>(m_keyFieldType & 0x7);
+            m_fieldId = static_cast<uint32_t>(m_keyFieldType >> 3);
+            bool fieldComplete{false};
+            switch (m_protoType) {
+                case ProtoConstants::VARINT:
+                {
+                    fieldComplete = (0 < fromVarInt(data, end, m_value));
+                }
+                break;
+                case ProtoConstants::EIGHT_BYTES:
+                {
+                    if (static_cast<std::size_t>(end - data) >= sizeof(double)) {
+                        std::memcpy(m_doubleValue.buffer.data(), data, sizeof(double));
+                        m_doubleValue.uint64Value = le64toh(m_doubleValue.uint64Value);
+                        data += sizeof(double);
+                        fieldComplete = true;
+                    }
+                }
+                break;
+                case ProtoConstants::FOUR_BYTES:
+                {
+                    if (static_cast<std::size_t>(end - data) >= sizeof(float)) {
+                        std::memcpy(m_floatValue.buffer.data(), data, sizeof(float));
+                        m_floatValue.uint32Value = le32toh(m_floatValue.uint32Value);
+                        data += sizeof(float);
+                        fieldComplete = true;
+                    }
+                }
+                break;
+                case ProtoConstants::LENGTH_DELIMITED:
+                {
+                    if ((0 < fromVarInt(data, end, m_value)) && (static_cast<uint64_t>(end - data) >= m_value)) {
+                        m_lengthDelimitedValue = data;
+                        data += m_value;
+                        fieldComplete = true;
+                    }
+                }
+                break;
+            }
+            if (!fieldComplete) {
+                break;
+            }
+            v.accept(m_fieldId, *this);
+        }
+        m_lengthDelimitedValue = nullptr;
+        m_callToDecodeFromWithDirectVisit = false;
+    }
+
    private:
     int8_t fromZigZag8(uint8_t v) noexcept;
     int16_t fromZigZag16(uint16_t v) noexcept;
@@ -7033,6 +7141,7 @@ class LIBCLUON_API FromProtoVisitor {
     int64_t fromZigZag64(uint64_t v) noexcept;
 
     std::size_t fromVarInt(std::istream &in, uint64_t &value) noexcept;
+    std::size_t fromVarInt(const char *&data, const char *end, uint64_t &value) noexcept;
 
     void readBytesFromStream(std::istream &in, std::size_t bytesToReadFromStream, char *buffer) noexcept;
 
@@ -7063,6 +7172,10 @@ class LIBCLUON_API FromProtoVisitor {
     // Buffer for strings.
     std::vector<char> m_stringValue;
 
+    // Start of the current length-delimited value; either in m_stringValue
+    // or in place in the bytes handed to decodeFrom(data, size, v).
+    const char *m_lengthDelimitedValue{nullptr};
+
     uint64_t m_keyFieldType{0};
     ProtoConstants m_protoType{ProtoConstants::VARINT};
     uint32_t m_fieldId{0};
@@ -8119,18 +8232,212 @@ inline std::pair<bool, cluon::data::Envelope> extractEnvelope(std::istream &in)
 }
 
 /**
- * @return Extract a given Envelope's payload into the desired type.
+ * Fields of one Envelope in format
+ *
+ *    0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded cluon::data::Envelope
+ *
+ * as they are found in place in a buffer; serializedData points into the
+ * buffer, so the view is only valid as long as the buffer is.
+ */
+struct EnvelopeView {
+    int32_t dataType{0};
+    uint32_t senderStamp{0};
+    int32_t sentSeconds{0};
+    int32_t sentMicroseconds{0};
+    int32_t receivedSeconds{0};
+    int32_t receivedMicroseconds{0};
+    int32_t sampleTimeStampSeconds{0};
+    int32_t sampleTimeStampMicroseconds{0};
+    const char *serializedData{nullptr};
+    std::size_t serializedDataLength{0};
+    // Bytes taken by the Envelope including the OD4 header.
+    std::size_t length{0};
+
+    int64_t sampleTimeStampInMicroseconds() const noexcept {
+        return static_cast<int64_t>(sampleTimeStampSeconds) * static_cast<int64_t>(1000 * 1000) + static_cast<int64_t>(sampleTimeStampMicroseconds);
+    }
+};
+
+/**
+ * This method reads a Protobuf VarInt from [p, end) and advances p.
+ *
+ * @return true if a complete VarInt was read.
+ */
+inline bool readVarInt(const char *&p, const char *end, uint64_t &value) noexcept {
+    value = 0;
+    for (uint32_t shift{0}; (p < end) && (shift < 64); shift += 7) {
+        const uint64_t C{static_cast<uint8_t>(*p++)};
+        value |= (C & 0x7f) << shift;
+        if (!(C & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * This method decodes a Proto-encoded cluon::data::TimeStamp from [p, end).
+ *
+ * @return true if the TimeStamp could be decoded.
+ */
+inline bool parseTimeStamp(const char *p, const char *end, int32_t &seconds, int32_t &microseconds) noexcept {
+    while (p < end) {
+        uint64_t key{0};
+        uint64_t value{0};
+        if (!readVarInt(p, end, key) || (0 != (key & 0x7)) || !readVarInt(p, end, value)) {
+            return false;
+        }
+        const int32_t v{static_cast<int32_t>((static_cast<uint32_t>(value) >> 1) ^ -(static_cast<uint32_t>(value) & 1))};
+        if (1 == (key >> 3)) {
+            seconds = v;
+        } else if (2 == (key >> 3)) {
+            microseconds = v;
+        }
+    }
+    return true;
+}
+
+/**
+ * This method parses the Envelope at the beginning of [data, data + size)
+ * in place: neither the header nor the payload are copied and nothing is
+ * allocated. Unknown fields are skipped.
+ *
+ * @param data Buffer to parse.
+ * @param size Bytes available in the buffer.
+ * @param view Fields of the Envelope; serializedData points into data.
+ * @return true if a complete Envelope was found.
+ */
+inline bool parseEnvelope(const char *data, std::size_t size, EnvelopeView &view) noexcept {
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    view = EnvelopeView();
+    if ((nullptr == data) || (size < OD4_HEADER_SIZE) || (0x0D != static_cast<uint8_t>(data[0])) || (0xA4 != static_cast<uint8_t>(data[1]))) {
+        return false;
+    }
+    const std::size_t LENGTH{static_cast<std::size_t>(static_cast<uint8_t>(data[2])) | (static_cast<std::size_t>(static_cast<uint8_t>(data[3])) << 8)
+                             | (static_cast<std::size_t>(static_cast<uint8_t>(data[4])) << 16)};
+    if (size - OD4_HEADER_SIZE < LENGTH) {
+        return false;
+    }
+    view.length = OD4_HEADER_SIZE + LENGTH;
+
+    const char *p{data + OD4_HEADER_SIZE};
+    const char *end{p + LENGTH};
+    while (p < end) {
+        uint64_t key{0};
+        if (!readVarInt(p, end, key)) {
+            return false;
+        }
+        const uint32_t FIELD{static_cast<uint32_t>(key >> 3)};
+        uint64_t value{0};
+        switch (key & 0x7) {
+            case 0: // VARINT
+                if (!readVarInt(p, end, value)) {
+                    return false;
+                }
+                if (1 == FIELD) {
+                    view.dataType = static_cast<int32_t>((static_cast<uint32_t>(value) >> 1) ^ -(static_cast<uint32_t>(value) & 1));
+                } else if (6 == FIELD) {
+                    view.senderStamp = static_cast<uint32_t>(value);
+                }
+                break;
+            case 1: // EIGHT_BYTES
+                if (end - p < 8) {
+                    return false;
+                }
+                p += 8;
+                break;
+            case 2: // LENGTH_DELIMITED
+            {
+                if (!readVarInt(p, end, value) || (static_cast<uint64_t>(end - p) < value)) {
+                    return false;
+                }
+                const char *FIELD_END{p + value};
+                bool retVal{true};
+                if (2 == FIELD) {
+                    view.serializedData       = p;
+                    view.serializedDataLength = static_cast<std::size_t>(value);
+                } else if (3 == FIELD) {
+                    retVal = parseTimeStamp(p, FIELD_END, view.sentSeconds, view.sentMicroseconds);
+                } else if (4 == FIELD) {
+                    retVal = parseTimeStamp(p, FIELD_END, view.receivedSeconds, view.receivedMicroseconds);
+                } else if (5 == FIELD) {
+                    retVal = parseTimeStamp(p, FIELD_END, view.sampleTimeStampSeconds, view.sampleTimeStampMicroseconds);
+                }
+                if (!retVal) {
+                    return false;
+                }
+                p = FIELD_END;
+            } break;
+            case 5: // FOUR_BYTES
+                if (end - p < 4) {
+                    return false;
+                }
+                p += 4;
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @return cluon::data::Envelope holding a copy of the fields of view; throws
+ *         std::bad_alloc if the payload cannot be copied.
+ */
+inline cluon::data::Envelope toEnvelope(const EnvelopeView &view) {
+    cluon::data::Envelope env;
+    cluon::data::TimeStamp sent;
+    cluon::data::TimeStamp received;
+    cluon::data::TimeStamp sampleTimeStamp;
+    sent.seconds(view.sentSeconds).microseconds(view.sentMicroseconds);
+    received.seconds(view.receivedSeconds).microseconds(view.receivedMicroseconds);
+    sampleTimeStamp.seconds(view.sampleTimeStampSeconds).microseconds(view.sampleTimeStampMicroseconds);
+    env.dataType(view.dataType)
+        .serializedData(std::string(view.serializedData, view.serializedDataLength))
+        .sent(sent)
+        .received(received)
+        .sampleTimeStamp(sampleTimeStamp)
+        .senderStamp(view.senderStamp);
+    return env;
+}
+
+/**
+ * This method decodes with the decode() method that cluon-msc generates
+ * for every message; used if T provides it.
  */
 template <typename T>
-inline T extractMessage(cluon::data::Envelope &&envelope) noexcept {
-    cluon::FromProtoVisitor decoder;
+inline auto decodeMessage(const char *data, std::size_t size, T &msg, int) noexcept -> decltype(msg.decode(data, size), void()) {
+    msg.decode(data, size);
+}
 
-    std::stringstream sstr(envelope.serializedData());
-    decoder.decodeFrom(sstr);
+/**
+ * This method decodes with the FromProtoVisitor for messages without a generated decode() method.
+ */
+template <typename T>
+inline void decodeMessage(const char *data, std::size_t size, T &msg, long) noexcept {
+    cluon::FromProtoVisitor decoder;
+    decoder.decodeFrom(data, size, msg);
+}
 
+/**
+ * @return Extract a given Envelope's payload into the desired type.
+ */
+template <typename T>
+inline T extractMessage(cluon::data::Envelope &&envelope) noexcept {
     T msg;
-    msg.accept(decoder);
+    const std::string &DATA{envelope.serializedData()};
+    decodeMessage(DATA.data(), DATA.size(), msg, 0);
+    return msg;
+}
 
+/**
+ * @return Extract the payload of a given EnvelopeView into the desired type.
+ */
+template <typename T>
+inline T extractMessage(const EnvelopeView &envelope) noexcept {
+    T msg;
+    decodeMessage(envelope.serializedData, envelope.serializedDataLength, msg, 0);
     return msg;
 }
 
@@ -8871,6 +9178,7 @@ class LIBCLUON_API LCMToGenericMessage {
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace cluon {
 /**
@@ -8906,6 +9214,16 @@ MyMessage msg;
 od4.send(msg);
 \endcode
 
+Data-triggered delegates are looked up without locking: every call to dataTrigger
+or dataViewTrigger publishes a new, immutable table of delegates that the receiving
+thread picks up with the next Envelope. Hence, a slow delegate only delays Envelopes
+arriving after it. To not even delay Envelopes of other message identifiers, a
+delegate can be run in a separate thread:
+
+\code{.cpp}
+od4.dataTrigger(MyMessage::ID(), [](cluon::data::Envelope &&envelope){ slowProcessing(envelope);}, true);
+\endcode
+
 Next to receive Envelopes, OD4Session can call a user-supplied lambda in a time-triggered
 way. The lambda is executed as long as it does not return false or throws an exception
 that is then caught in the method timeTrigger and the method is exited:
@@ -8946,15 +9264,32 @@ class LIBCLUON_API OD4Session {
      */
     void send(cluon::data::Envelope &&envelope) noexcept;
 
+    ~OD4Session();
+
     /**
      * This method sets a delegate to be called data-triggered on arrival
      * of a new Envelope for a given message identifier.
      *
      * @param messageIdentifier Message identifier to assign a delegate.
      * @param delegate Function to call on newly arriving Envelopes; setting it to nullptr will erase it.
+     * @param inSeparateThread If true, the delegate is called from a thread of its own
+     *        that processes the Envelopes for messageIdentifier in their order of arrival.
+     * @return true if the given delegate could be successfully set or unset.
+     */
+    bool dataTrigger(int32_t messageIdentifier, std::function<void(cluon::data::Envelope &&envelope)> delegate, bool inSeparateThread = false) noexcept;
+
+    /**
+     * This method sets a delegate to be called data-triggered on arrival
+     * of a new Envelope for a given message identifier. Other than with
+     * dataTrigger, the received datagram is not copied into an Envelope:
+     * the delegate gets a view into it that is only valid during the call;
+     * use cluon::toEnvelope to keep the Envelope beyond.
+     *
+     * @param messageIdentifier Message identifier to assign a delegate.
+     * @param delegate Function to call on newly arriving Envelopes; setting it to nullptr will erase it.
      * @return true if the given delegate could be successfully set or unset.
      */
-    bool dataTrigger(int32_t messageIdentifier, std::function<void(cluon::data::Envelope &&envelope)> delegate) noexcept;
+    bool dataViewTrigger(int32_t messageIdentifier, std::function<void(const cluon::EnvelopeView &envelope)> delegate) noexcept;
 
     /**
      * This method sets a delegate to be called time-triggered using the
@@ -8998,9 +9333,35 @@ class LIBCLUON_API OD4Session {
    public:
     bool isRunning() noexcept;
 
+   private:
+    /**
+     * Delegates for one message identifier.
+     */
+    struct DataTriggeredDelegate {
+        int32_t m_dataType{0};
+        std::function<void(const cluon::EnvelopeView &envelope)> m_viewDelegate{nullptr};
+        std::function<void(cluon::data::Envelope &&envelope)> m_delegate{nullptr};
+        // Set when m_delegate is run in a separate thread.
+        std::shared_ptr<cluon::NotifyingPipeline<cluon::data::Envelope>> m_pipeline{nullptr};
+    };
+
+    /**
+     * Immutable table of all data-triggered delegates, sorted by message identifier.
+     * When the message identifiers are close to each other, m_index maps
+     * (dataType - m_firstDataType) directly to the position in m_delegates.
+     */
+    struct DataTriggeredDelegates {
+        std::vector<DataTriggeredDelegate> m_delegates{};
+        int32_t m_firstDataType{0};
+        std::vector<uint32_t> m_index{};
+
+        const DataTriggeredDelegate *find(int32_t dataType) const noexcept;
+    };
+
    private:
     void callback(std::string &&data, std::string &&from, std::chrono::system_clock::time_point &&timepoint) noexcept;
     void sendInternal(std::string &&dataToSend) noexcept;
+    void publishDataTriggeredDelegates();
 
    private:
     std::unique_ptr<cluon::UDPReceiver> m_receiver;
@@ -9010,8 +9371,18 @@ class LIBCLUON_API OD4Session {
 
     std::function<void(cluon::data::Envelope &&envelope)> m_delegate{nullptr};
 
+    // Registered delegates; only accessed by the registering methods.
     std::mutex m_mapOfDataTriggeredDelegatesMutex{};
     std::unordered_map<int32_t, std::function<void(cluon::data::Envelope &&envelope)>, UseUInt32ValueAsHashKey> m_mapOfDataTriggeredDelegates{};
+    std::unordered_map<int32_t, std::function<void(const cluon::EnvelopeView &envelope)>, UseUInt32ValueAsHashKey> m_mapOfDataTriggeredViewDelegates{};
+    std::unordered_map<int32_t, std::shared_ptr<cluon::NotifyingPipeline<cluon::data::Envelope>>, UseUInt32ValueAsHashKey> m_mapOfDataTriggeredPipelines{};
+
+    // Snapshot of the registered delegates used by the receiving thread. Replaced
+    // snapshots are kept with their pipelines until the OD4Session is destroyed as
+    // the receiving thread might still use them; hence, every registration keeps
+    // one table alive and pipelines are never joined from the receiving thread.
+    std::atomic<const DataTriggeredDelegates *> m_dataTriggeredDelegates{nullptr};
+    std::vector<std::unique_ptr<const DataTriggeredDelegates>> m_publishedDataTriggeredDelegates{};
 };
 
 } // namespace cluon
@@ -9034,24 +9405,38 @@ class LIBCLUON_API OD4Session {
 #include <deque>
 #include <fstream>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace cluon {
 
-class LIBCLUON_API IndexEntry {
-   public:
-    IndexEntry() = default;
-    IndexEntry(const int64_t &sampleTimeStamp, const uint64_t &filePosition) noexcept;
+/**
+ * Layout of the index file stored next to a .rec file (<file>.rec.idx):
+ * one IndexFileHeader followed by IndexFileHeader::numberOfEntries
+ * IndexFileEntry sorted by sample time stamp in replay order. The index
+ * is only used while size and modification time of the .rec file match;
+ * the Player replays straight from the mapped entries. The entries are
+ * checked once when the file is written and trusted when it is loaded;
+ * each one is bounds-checked when its Envelope is read.
+ */
+struct IndexFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entrySize;
+    uint64_t recFileSize;
+    int64_t recFileModificationTime;
+    uint64_t numberOfEntries;
+};
 
-   public:
-    int64_t m_sampleTimeStamp{0};
-    uint64_t m_filePosition{0};
-    bool m_available{0};
+struct IndexFileEntry {
+    int64_t sampleTimeStamp;
+    uint64_t filePosition;
 };
 
 class LIBCLUON_API Player {
@@ -9063,6 +9448,7 @@ class LIBCLUON_API Player {
         LOOK_AHEAD_IN_S                 = 30,
         MIN_ENTRIES_FOR_LOOK_AHEAD      = 5000,
     };
+    static constexpr int64_t UNKNOWN_MODIFICATION_TIME{(std::numeric_limits<int64_t>::min)()};
 
    private:
     Player(const Player &) = delete;
@@ -9113,6 +9499,46 @@ class LIBCLUON_API Player {
     // Internal methods without Lock.
     bool hasMoreDataFromRecFile() const noexcept;
 
+    /**
+     * This method opens the .rec file: it is mapped into memory if possible
+     * and read through a stream otherwise.
+     *
+     * @return true if the file could be opened.
+     */
+    bool openRecFile() noexcept;
+
+    /**
+     * This method maps the .rec file into memory.
+     *
+     * @return true if the file could be mapped.
+     */
+    bool mapRecFile() noexcept;
+
+    /**
+     * This method provides the bytes of the .rec file starting at position:
+     * all remaining bytes if the file is mapped, otherwise the Envelope at
+     * position (or its broken header) read into m_recFileBuffer.
+     *
+     * @param position Position in the .rec file.
+     * @param size Bytes available at the returned pointer.
+     * @return Pointer to the bytes or nullptr if nothing could be read.
+     */
+    const char *recFileDataAt(const uint64_t &position, std::size_t &size) noexcept;
+
+    /**
+     * This method maps the index file next to the .rec file as the global
+     * index if it belongs to the current content of the .rec file.
+     *
+     * @return true if the index could be loaded.
+     */
+    bool loadIndexFile() noexcept;
+
+    /**
+     * This method stores the global index next to the .rec file to
+     * speed up the next opening of the same file.
+     */
+    void writeIndexFile() const noexcept;
+
     /**
      * This method initializes the global index where the sample
      * time stamps are sorted chronocally and mapped to the
@@ -9156,26 +9582,38 @@ class LIBCLUON_API Player {
 
     std::string m_file;
 
-    // Handle to .rec file.
+    // .rec file mapped into memory; envelopes are parsed in place. Where it
+    // cannot be mapped, m_recFileData is nullptr and envelopes are read one by
+    // one from m_recFile into m_recFileBuffer.
+    const char *m_recFileData;
+    uint64_t m_recFileSize;
+    // Modification time in nanoseconds; UNKNOWN_MODIFICATION_TIME if it could not be determined.
+    int64_t m_recFileModificationTime;
     std::fstream m_recFile;
+    std::string m_recFileBuffer;
     bool m_recFileValid;
 
    private: // Player states.
     bool m_autoRewind;
 
    private: // Index and cache management.
-    // Global index: Mapping SampleTimeStamp --> cache entry (holding the actual content from .rec file).
+    // Global index: array of SampleTimeStamp and .rec file position sorted in
+    // replay order, either the mapped index file or m_indexEntries.
     mutable std::mutex m_indexMutex;
-    std::multimap<int64_t, IndexEntry> m_index;
-
-    // Pointers to the current envelope to be replayed and the
-    // envelope that has be replayed from the global index.
-    std::multimap<int64_t, IndexEntry>::iterator m_previousPreviousEnvelopeAlreadyReplayed;
-    std::multimap<int64_t, IndexEntry>::iterator m_previousEnvelopeAlreadyReplayed;
-    std::multimap<int64_t, IndexEntry>::iterator m_currentEnvelopeToReplay;
+    const IndexFileEntry *m_index;
+    std::size_t m_indexSize;
+    std::vector<IndexFileEntry> m_indexEntries;
+    void *m_indexFileData;
+    std::size_t m_indexFileSize;
+
+    // Positions in the global index of the current envelope to be replayed and
+    // the envelopes that have been replayed; m_indexSize marks the end.
+    std::size_t m_previousPreviousEnvelopeAlreadyReplayed;
+    std::size_t m_previousEnvelopeAlreadyReplayed;
+    std::size_t m_currentEnvelopeToReplay;
 
     // Information about the index.
-    std::multimap<int64_t, IndexEntry>::iterator m_nextEntryToReadFromRecFile;
+    std::size_t m_nextEntryToReadFromRecFile;
 
     uint32_t m_desiredInitialLevel;
 
@@ -10177,6 +10615,7 @@ inline std::pair<ssize_t, int32_t> UDPSender::send(std::string &&data) const noe
 #else
     #ifdef __linux__
         #include <linux/sockios.h>
+        #include <sys/epoll.h>
     #endif
 
     #include <arpa/inet.h>
@@ -10207,8 +10646,10 @@ namespace cluon {
 inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
                          uint16_t receiveFromPort,
                          std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point &&)> delegate,
-                         uint16_t localSendFromPort) noexcept
+                         uint16_t localSendFromPort,
+                         bool withSender) noexcept
     : m_localSendFromPort(localSendFromPort)
+    , m_withSender(withSender)
     , m_receiveFromAddress()
     , m_mreq()
     , m_readFromSocketThread()
@@ -10314,6 +10755,28 @@ inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
             }
         }
 
+#ifdef __linux__
+        if (!(m_socket < 0)) {
+            // Let the kernel time stamp every datagram; the time stamps arrive as control messages with the data.
+            int32_t YES{1};
+            m_hasKernelTimeStamps = (0 == ::setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPNS, &YES, sizeof(YES)));
+
+            const char *CLUON_UDPRECEIVER_BUSY_POLL = getenv("CLUON_UDPRECEIVER_BUSY_POLL");
+            if (nullptr != CLUON_UDPRECEIVER_BUSY_POLL) {
+                m_busyPollInMicroseconds = static_cast<uint32_t>(std::strtoul(CLUON_UDPRECEIVER_BUSY_POLL, nullptr, 10));
+            }
+#ifdef SO_BUSY_POLL
+            if (0 < m_busyPollInMicroseconds) {
+                int32_t busyPoll{static_cast<int32_t>(m_busyPollInMicroseconds)};
+                if (0 > ::setsockopt(m_socket, SOL_SOCKET, SO_BUSY_POLL, &busyPoll, sizeof(busyPoll))) {
+                    // Raising SO_BUSY_POLL needs CAP_NET_ADMIN; polling without sleeping works nonetheless.
+                    std::cerr << "[cluon::UDPReceiver] Error while trying to set SO_BUSY_POLL to " << busyPoll << ": " << errno << std::endl;
+                }
+            }
+#endif
+        }
+#endif
+
         if (!(m_socket < 0)) {
             // Bind to receive address/port.
             // clang-format off
@@ -10398,8 +10861,16 @@ inline UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
             } catch (...) { closeSocket(ECHILD); } // LCOV_EXCL_LINE
 
             try {
-                m_pipeline = std::make_shared<cluon::NotifyingPipeline<PipelineEntry>>(
-                    [this](PipelineEntry &&entry) { this->m_delegate(std::move(entry.m_data), std::move(entry.m_from), std::move(entry.m_sampleTime)); });
+                m_pipeline = std::make_shared<cluon::NotifyingPipeline<PipelineEntry>>([this](PipelineEntry &&entry) {
+                    std::string from;
+                    if (m_withSender) {
+                        // Transform sender address to C-string.
+                        std::array<char, INET_ADDRSTRLEN> remoteAddress{};
+                        ::inet_ntop(AF_INET, &(entry.m_from.sin_addr), remoteAddress.data(), remoteAddress.max_size());
+                        from = std::string(remoteAddress.data()) + ':' + std::to_string(ntohs(entry.m_from.sin_port));
+                    }
+                    this->m_delegate(std::move(entry.m_data), std::move(from), std::move(entry.m_sampleTime));
+                });
                 if (m_pipeline) {
                     // Let the operating system spawn the thread.
                     using namespace std::literals::chrono_literals; // NOLINT
@@ -10463,7 +10934,136 @@ inline bool UDPReceiver::isRunning() const noexcept {
     return (m_readFromSocketThreadRunning.load() && !TerminateHandler::instance().isTerminated.load());
 }
 
+inline bool UDPReceiver::addToPipeline(const char *data, std::size_t length, const struct sockaddr_in &from, const std::chrono::system_clock::time_point &timestamp) noexcept {
+    const unsigned long RECVFROM_IP{from.sin_addr.s_addr};
+    const uint16_t RECVFROM_PORT{ntohs(from.sin_port)};
+
+    // Check if the bytes actually came from us.
+    bool sentFromUs{false};
+    {
+        auto pos                   = m_listOfLocalIPAddresses.find(RECVFROM_IP);
+        const bool sentFromLocalIP = (pos != m_listOfLocalIPAddresses.end() && (*pos == RECVFROM_IP));
+        sentFromUs                 = sentFromLocalIP && (m_localSendFromPort == RECVFROM_PORT);
+    }
+
+    // Create a pipeline entry to be processed concurrently.
+    if (!sentFromUs && m_pipeline) {
+        try {
+            PipelineEntry pe;
+            pe.m_data       = std::string(data, length);
+            pe.m_from       = from;
+            pe.m_sampleTime = timestamp;
+
+            // Store entry in queue.
+            m_pipeline->add(std::move(pe));
+            return true;
+        } catch (...) {} // LCOV_EXCL_LINE
+    }
+    return false;
+}
+
+#ifdef __linux__
+inline bool UDPReceiver::readFromSocketBatched() noexcept {
+    constexpr uint16_t MAX_LENGTH = static_cast<uint16_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                    - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                    - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    constexpr uint32_t BATCH{16};
+
+    // One buffer per datagram of a batch; control messages carry the kernel time stamps.
+    std::vector<char> buffers(static_cast<std::size_t>(BATCH) * MAX_LENGTH);
+    std::array<struct mmsghdr, BATCH> messages{};
+    std::array<struct iovec, BATCH> iovecs{};
+    std::array<struct sockaddr_in, BATCH> remotes{};
+    std::array<ControlMessage, BATCH> controlMessages{};
+    for (uint32_t i{0}; i < BATCH; i++) {
+        iovecs[i].iov_base = &buffers[static_cast<std::size_t>(i) * MAX_LENGTH];
+        iovecs[i].iov_len  = MAX_LENGTH;
+    }
+
+    // Wait for data with epoll: every 20ms to check for termination, or not at all when busy polling.
+    const int EPOLL{::epoll_create1(0)};
+    struct epoll_event event {};
+    event.events  = EPOLLIN;
+    event.data.fd = m_socket;
+    if ((0 > EPOLL) || (0 > ::epoll_ctl(EPOLL, EPOLL_CTL_ADD, m_socket, &event))) {
+        std::cerr << "[cluon::UDPReceiver] Error while waiting for data with epoll, falling back to select: " << errno << std::endl; // LCOV_EXCL_LINE
+        if (!(0 > EPOLL)) { // LCOV_EXCL_LINE
+            ::close(EPOLL); // LCOV_EXCL_LINE
+        }
+        return false; // LCOV_EXCL_LINE
+    }
+    const int TIMEOUT_IN_MILLISECONDS{(0 < m_busyPollInMicroseconds) ? 0 : 20};
+
+    // Indicate to main thread that we are ready.
+    m_readFromSocketThreadRunning.store(true);
+
+    while (m_readFromSocketThreadRunning.load()) {
+        struct epoll_event readyEvent {};
+        if (0 < ::epoll_wait(EPOLL, &readyEvent, 1, TIMEOUT_IN_MILLISECONDS)) {
+            std::size_t datagramsAdded{0};
+            int received{0};
+            do {
+                // Sizes of addresses and control messages are updated by every call.
+                for (uint32_t i{0}; i < BATCH; i++) {
+                    messages[i].msg_hdr.msg_name       = &remotes[i];
+                    messages[i].msg_hdr.msg_namelen    = sizeof(struct sockaddr_in);
+                    messages[i].msg_hdr.msg_iov        = &iovecs[i];
+                    messages[i].msg_hdr.msg_iovlen     = 1;
+                    messages[i].msg_hdr.msg_control    = controlMessages[i].buffer;
+                    messages[i].msg_hdr.msg_controllen = sizeof(ControlMessage);
+                    messages[i].msg_hdr.msg_flags      = 0;
+                    messages[i].msg_len                = 0;
+                }
+
+                received = ::recvmmsg(m_socket, messages.data(), BATCH, MSG_DONTWAIT, nullptr);
+                for (int i{0}; i < received; i++) {
+                    if ((0 < messages[i].msg_len) && (nullptr != m_delegate)) {
+                        std::chrono::system_clock::time_point timestamp;
+                        if (!kernelTimeStamp(messages[i].msg_hdr, timestamp)) {
+                            timestamp = std::chrono::system_clock::now(); // LCOV_EXCL_LINE
+                        }
+
+                        if (addToPipeline(&buffers[static_cast<std::size_t>(i) * MAX_LENGTH], messages[i].msg_len, remotes[i], timestamp)) {
+                            datagramsAdded++;
+                        }
+                    }
+                }
+                // A full batch indicates that more datagrams are waiting.
+            } while (static_cast<int>(BATCH) == received);
+
+            if ((0 < datagramsAdded) && m_pipeline) {
+                m_pipeline->notifyAll();
+            }
+        }
+    }
+
+    ::close(EPOLL);
+    return true;
+}
+
+inline bool UDPReceiver::kernelTimeStamp(struct msghdr &message, std::chrono::system_clock::time_point &timestamp) const noexcept {
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message); m_hasKernelTimeStamps && (nullptr != cmsg); cmsg = CMSG_NXTHDR(&message, cmsg)) {
+        if ((SOL_SOCKET == cmsg->cmsg_level) && (SCM_TIMESTAMPNS == cmsg->cmsg_type)) {
+            struct timespec receivedTimeStamp {};
+            std::memcpy(&receivedTimeStamp, CMSG_DATA(cmsg), sizeof(receivedTimeStamp));
+            // Transform struct timespec to C++ chrono.
+            std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> transformedTimePoint(
+                std::chrono::nanoseconds(static_cast<int64_t>(receivedTimeStamp.tv_sec) * static_cast<int64_t>(1000000000) + receivedTimeStamp.tv_nsec));
+            timestamp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(transformedTimePoint);
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
 inline void UDPReceiver::readFromSocket() noexcept {
+#ifdef __linux__
+    if (readFromSocketBatched()) {
+        return;
+    }
+    // Without epoll, wait for data with select like on the other platforms.
+#endif
     // Create buffer to store data from socket.
     constexpr uint16_t MAX_LENGTH = static_cast<uint16_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
                                     - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
@@ -10476,11 +11076,10 @@ inline void UDPReceiver::readFromSocket() noexcept {
     fd_set setOfFiledescriptorsToReadFrom{};
 
     // Sender address and port.
-    constexpr uint16_t MAX_ADDR_SIZE{1024};
-    std::array<char, MAX_ADDR_SIZE> remoteAddress{};
-
     struct sockaddr_storage remote {};
+#ifndef __linux__
     socklen_t addrLength{sizeof(remote)};
+#endif
 
     // Indicate to main thread that we are ready.
     m_readFromSocketThreadRunning.store(true);
@@ -10500,58 +11099,49 @@ inline void UDPReceiver::readFromSocket() noexcept {
         if (FD_ISSET(m_socket, &setOfFiledescriptorsToReadFrom)) { // NOLINT
             ssize_t bytesRead{0};
             do {
+#ifdef __linux__
+                // Receive the kernel time stamp of the datagram along with it, like the batched reading.
+                struct iovec iov {};
+                iov.iov_base = buffer.data();
+                iov.iov_len  = buffer.max_size();
+                ControlMessage controlMessage{};
+                struct msghdr message {};
+                message.msg_name       = &remote;
+                message.msg_namelen    = sizeof(remote);
+                message.msg_iov        = &iov;
+                message.msg_iovlen     = 1;
+                message.msg_control    = controlMessage.buffer;
+                message.msg_controllen = sizeof(ControlMessage);
+                bytesRead              = ::recvmsg(m_socket, &message, 0);
+#else
                 bytesRead = ::recvfrom(m_socket,
                                        buffer.data(),
                                        buffer.max_size(),
                                        0,
                                        reinterpret_cast<struct sockaddr *>(&remote), // NOLINT
                                        reinterpret_cast<socklen_t *>(&addrLength));  // NOLINT
+#endif
 
                 if ((0 < bytesRead) && (nullptr != m_delegate)) {
 #ifdef __linux__
                     std::chrono::system_clock::time_point timestamp;
-                    struct timeval receivedTimeStamp {};
-                    if (0 == ::ioctl(m_socket, SIOCGSTAMP, &receivedTimeStamp)) { // NOLINT
-                        // Transform struct timeval to C++ chrono.
-                        std::chrono::time_point<std::chrono::system_clock, std::chrono::microseconds> transformedTimePoint(
-                            std::chrono::microseconds(receivedTimeStamp.tv_sec * 1000000L + receivedTimeStamp.tv_usec));
-                        timestamp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(transformedTimePoint);
-                    } else { // LCOV_EXCL_LINE
-                        // In case the ioctl failed, fall back to chrono. // LCOV_EXCL_LINE
-                        timestamp = std::chrono::system_clock::now(); // LCOV_EXCL_LINE
+                    if (!kernelTimeStamp(message, timestamp)) {
+                        // Without SO_TIMESTAMPNS, ask the kernel for the time stamp of the last datagram.
+                        struct timeval receivedTimeStamp {};
+                        if (0 == ::ioctl(m_socket, SIOCGSTAMP, &receivedTimeStamp)) { // NOLINT
+                            // Transform struct timeval to C++ chrono.
+                            std::chrono::time_point<std::chrono::system_clock, std::chrono::microseconds> transformedTimePoint(
+                                std::chrono::microseconds(receivedTimeStamp.tv_sec * 1000000L + receivedTimeStamp.tv_usec));
+                            timestamp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(transformedTimePoint);
+                        } else { // LCOV_EXCL_LINE
+                            // In case the ioctl failed, fall back to chrono. // LCOV_EXCL_LINE
+                            timestamp = std::chrono::system_clock::now(); // LCOV_EXCL_LINE
+                        }
                     }
 #else
                     std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
 #endif
-
-                    // Transform sender address to C-string.
-                    ::inet_ntop(remote.ss_family,
-                                &((reinterpret_cast<struct sockaddr_in *>(&remote))->sin_addr), // NOLINT
-                                remoteAddress.data(),
-                                remoteAddress.max_size());
-                    const unsigned long RECVFROM_IP{reinterpret_cast<struct sockaddr_in *>(&remote)->sin_addr.s_addr}; // NOLINT
-                    const uint16_t RECVFROM_PORT{ntohs(reinterpret_cast<struct sockaddr_in *>(&remote)->sin_port)};    // NOLINT
-
-                    // Check if the bytes actually came from us.
-                    bool sentFromUs{false};
-                    {
-                        auto pos                   = m_listOfLocalIPAddresses.find(RECVFROM_IP);
-                        const bool sentFromLocalIP = (pos != m_listOfLocalIPAddresses.end() && (*pos == RECVFROM_IP));
-                        sentFromUs                 = sentFromLocalIP && (m_localSendFromPort == RECVFROM_PORT);
-                    }
-
-                    // Create a pipeline entry to be processed concurrently.
-                    if (!sentFromUs) {
-                        PipelineEntry pe;
-                        pe.m_data       = std::string(buffer.data(), static_cast<size_t>(bytesRead));
-                        pe.m_from       = std::string(remoteAddress.data()) + ':' + std::to_string(RECVFROM_PORT);
-                        pe.m_sampleTime = timestamp;
-
-                        // Store entry in queue.
-                        if (m_pipeline) {
-                            m_pipeline->add(std::move(pe));
-                        }
-                    }
+                    addToPipeline(buffer.data(), static_cast<size_t>(bytesRead), *reinterpret_cast<struct sockaddr_in *>(&remote), timestamp); // NOLINT
                     totalBytesRead += bytesRead;
                 }
             } while (!m_isBlockingSocket && (bytesRead > 0));
@@ -11537,7 +12127,7 @@ inline void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::st
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = std::string(m_stringValue.data(), static_cast<std::size_t>(m_value));
+        v.assign(m_lengthDelimitedValue, static_cast<std::size_t>(m_value));
     }
     else if (m_mapOfKeyValues.count(id) > 0) {
         try {
@@ -11585,6 +12175,26 @@ inline std::size_t FromProtoVisitor::fromVarInt(std::istream &in, uint64_t &valu
 
     return size;
 }
+
+inline std::size_t FromProtoVisitor::fromVarInt(const char *&data, const char *end, uint64_t &value) noexcept {
+    value = 0;
+
+    constexpr uint64_t MASK  = 0x7f;
+    constexpr uint64_t SHIFT = 0x7;
+    constexpr uint64_t MSB   = 0x80;
+
+    std::size_t size = 0;
+    while ((data < end) && (size < 10)) {
+        const uint64_t C{static_cast<uint8_t>(*data++)};
+        value |= (C & MASK) << (SHIFT * size++);
+        if (!(C & MSB)) { // NOLINT
+            return size;
+        }
+    }
+
+    // Incomplete VarInt.
+    return 0;
+}
 } // namespace cluon
 /*
  * Copyright (C) 2017-2018  Christian Berger
@@ -13934,7 +14544,9 @@ inline void ToMsgPackVisitor::visit(uint32_t id, std::string &&typeName, std::st
 //#include "cluon/TerminateHandler.hpp"
 //#include "cluon/Time.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <thread>
 
@@ -13945,14 +14557,24 @@ inline OD4Session::OD4Session(uint16_t CID, std::function<void(cluon::data::Enve
     , m_sender{"225.0.0." + std::to_string(CID), 12175}
     , m_delegate(std::move(delegate))
     , m_mapOfDataTriggeredDelegatesMutex{}
-    , m_mapOfDataTriggeredDelegates{} {
+    , m_mapOfDataTriggeredDelegates{}
+    , m_mapOfDataTriggeredViewDelegates{}
+    , m_mapOfDataTriggeredPipelines{}
+    , m_dataTriggeredDelegates{nullptr}
+    , m_publishedDataTriggeredDelegates{} {
     m_receiver = std::make_unique<cluon::UDPReceiver>(
         "225.0.0." + std::to_string(CID),
         12175,
         [this](std::string &&data, std::string &&from, std::chrono::system_clock::time_point &&timepoint) {
             this->callback(std::move(data), std::move(from), std::move(timepoint));
         },
-        m_sender.getSendFromPort() /* passing our local send from port to the UDPReceiver to filter out our own bytes */);
+        m_sender.getSendFromPort() /* passing our local send from port to the UDPReceiver to filter out our own bytes */,
+        false /* the sender is not needed to dispatch Envelopes */);
+}
+
+inline OD4Session::~OD4Session() {
+    // Stop receiving before the delegates are destroyed.
+    m_receiver.reset();
 }
 
 inline void OD4Session::timeTrigger(float freq, std::function<bool()> delegate) noexcept {
@@ -13984,54 +14606,140 @@ inline void OD4Session::timeTrigger(float freq, std::function<bool()> delegate)
     }
 }
 
-inline bool OD4Session::dataTrigger(int32_t messageIdentifier, std::function<void(cluon::data::Envelope &&envelope)> delegate) noexcept {
+inline const OD4Session::DataTriggeredDelegate *OD4Session::DataTriggeredDelegates::find(int32_t dataType) const noexcept {
+    if (!m_index.empty()) {
+        const int64_t POSITION{static_cast<int64_t>(dataType) - m_firstDataType};
+        if ((0 <= POSITION) && (POSITION < static_cast<int64_t>(m_index.size()))) {
+            const uint32_t INDEX{m_index[static_cast<std::size_t>(POSITION)]};
+            return (INDEX < m_delegates.size()) ? &m_delegates[INDEX] : nullptr;
+        }
+        return nullptr;
+    }
+    auto it = std::lower_bound(m_delegates.begin(), m_delegates.end(), dataType, [](const DataTriggeredDelegate &d, int32_t t) { return d.m_dataType < t; });
+    return ((it != m_delegates.end()) && (it->m_dataType == dataType)) ? &(*it) : nullptr;
+}
+
+inline void OD4Session::publishDataTriggeredDelegates() {
+    // Must be called with m_mapOfDataTriggeredDelegatesMutex held.
+    std::unique_ptr<DataTriggeredDelegates> snapshot{new DataTriggeredDelegates()};
+    for (const auto &e : m_mapOfDataTriggeredViewDelegates) {
+        DataTriggeredDelegate d;
+        d.m_dataType     = e.first;
+        d.m_viewDelegate = e.second;
+        snapshot->m_delegates.push_back(d);
+    }
+    for (const auto &e : m_mapOfDataTriggeredDelegates) {
+        if (0 == m_mapOfDataTriggeredViewDelegates.count(e.first)) {
+            DataTriggeredDelegate d;
+            d.m_dataType = e.first;
+            snapshot->m_delegates.push_back(d);
+        }
+    }
+    std::sort(snapshot->m_delegates.begin(), snapshot->m_delegates.end(), [](const DataTriggeredDelegate &a, const DataTriggeredDelegate &b) {
+        return a.m_dataType < b.m_dataType;
+    });
+    for (auto &d : snapshot->m_delegates) {
+        auto delegate = m_mapOfDataTriggeredDelegates.find(d.m_dataType);
+        if (delegate != m_mapOfDataTriggeredDelegates.end()) {
+            d.m_delegate = delegate->second;
+            auto pipeline = m_mapOfDataTriggeredPipelines.find(d.m_dataType);
+            if (pipeline != m_mapOfDataTriggeredPipelines.end()) {
+                d.m_pipeline = pipeline->second;
+            }
+        }
+    }
+
+    // Index the delegates directly by message identifier unless they are too far apart.
+    constexpr int64_t MAX_INDEX_SIZE{4096};
+    if (!snapshot->m_delegates.empty()) {
+        const int64_t FIRST{snapshot->m_delegates.front().m_dataType};
+        const int64_t LAST{snapshot->m_delegates.back().m_dataType};
+        if (LAST - FIRST < MAX_INDEX_SIZE) {
+            snapshot->m_firstDataType = static_cast<int32_t>(FIRST);
+            snapshot->m_index.assign(static_cast<std::size_t>(LAST - FIRST + 1), std::numeric_limits<uint32_t>::max());
+            for (uint32_t i{0}; i < snapshot->m_delegates.size(); i++) {
+                snapshot->m_index[static_cast<std::size_t>(snapshot->m_delegates[i].m_dataType - FIRST)] = i;
+            }
+        }
+    }
+
+    m_dataTriggeredDelegates.store(snapshot.get());
+    m_publishedDataTriggeredDelegates.push_back(std::move(snapshot));
+}
+
+inline bool OD4Session::dataTrigger(int32_t messageIdentifier, std::function<void(cluon::data::Envelope &&envelope)> delegate, bool inSeparateThread) noexcept {
     bool retVal{false};
     if (nullptr == m_delegate) {
         try {
             std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
-            if ((nullptr == delegate) && (m_mapOfDataTriggeredDelegates.count(messageIdentifier) > 0)) {
-                auto element = m_mapOfDataTriggeredDelegates.find(messageIdentifier);
-                if (element != m_mapOfDataTriggeredDelegates.end()) {
-                    m_mapOfDataTriggeredDelegates.erase(element);
-                }
+            if (nullptr == delegate) {
+                m_mapOfDataTriggeredDelegates.erase(messageIdentifier);
+                m_mapOfDataTriggeredPipelines.erase(messageIdentifier);
             } else {
                 m_mapOfDataTriggeredDelegates[messageIdentifier] = delegate;
+                if (inSeparateThread) {
+                    m_mapOfDataTriggeredPipelines[messageIdentifier] = std::make_shared<cluon::NotifyingPipeline<cluon::data::Envelope>>(delegate);
+                } else {
+                    m_mapOfDataTriggeredPipelines.erase(messageIdentifier);
+                }
             }
+            publishDataTriggeredDelegates();
             retVal = true;
         } catch (...) {} // LCOV_EXCL_LINE
     }
     return retVal;
 }
 
-inline void OD4Session::callback(std::string &&data, std::string && /*from*/, std::chrono::system_clock::time_point &&timepoint) noexcept {
-    size_t numberOfDataTriggeredDelegates{0};
-    {
+inline bool OD4Session::dataViewTrigger(int32_t messageIdentifier, std::function<void(const cluon::EnvelopeView &envelope)> delegate) noexcept {
+    bool retVal{false};
+    if (nullptr == m_delegate) {
         try {
             std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
-            numberOfDataTriggeredDelegates = m_mapOfDataTriggeredDelegates.size();
+            if (nullptr == delegate) {
+                m_mapOfDataTriggeredViewDelegates.erase(messageIdentifier);
+            } else {
+                m_mapOfDataTriggeredViewDelegates[messageIdentifier] = delegate;
+            }
+            publishDataTriggeredDelegates();
+            retVal = true;
         } catch (...) {} // LCOV_EXCL_LINE
     }
-    // Only unpack the envelope when it needs to be post-processed.
-    if ((nullptr != m_delegate) || (0 < numberOfDataTriggeredDelegates)) {
-        std::stringstream sstr(data);
-        auto retVal = extractEnvelope(sstr);
+    return retVal;
+}
 
-        if (retVal.first) {
-            cluon::data::Envelope env{retVal.second};
-            env.received(cluon::time::convert(timepoint));
+inline void OD4Session::callback(std::string &&data, std::string && /*from*/, std::chrono::system_clock::time_point &&timepoint) noexcept {
+    // The snapshot stays valid while the delegates are called, even if it is replaced in the meantime.
+    const DataTriggeredDelegates *dataTriggeredDelegates{m_dataTriggeredDelegates.load()};
 
-            // "Catch all"-delegate.
-            if (nullptr != m_delegate) {
-                m_delegate(std::move(env));
-            } else {
-                try {
+    // Only unpack the envelope when it needs to be post-processed.
+    if ((nullptr != m_delegate) || ((nullptr != dataTriggeredDelegates) && !dataTriggeredDelegates->m_delegates.empty())) {
+        // The envelope is parsed in place; it is only copied for delegates taking a cluon::data::Envelope.
+        EnvelopeView view;
+        if (parseEnvelope(data.data(), data.size(), view)) {
+            const cluon::data::TimeStamp RECEIVED{cluon::time::convert(timepoint)};
+            view.receivedSeconds      = RECEIVED.seconds();
+            view.receivedMicroseconds = RECEIVED.microseconds();
+
+            try {
+                // "Catch all"-delegate.
+                if (nullptr != m_delegate) {
+                    m_delegate(toEnvelope(view));
+                } else {
                     // Data triggered-delegates.
-                    std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
-                    if (m_mapOfDataTriggeredDelegates.count(env.dataType()) > 0) {
-                        m_mapOfDataTriggeredDelegates[env.dataType()](std::move(env));
+                    const DataTriggeredDelegate *d{dataTriggeredDelegates->find(view.dataType)};
+                    if (nullptr != d) {
+                        if (nullptr != d->m_viewDelegate) {
+                            d->m_viewDelegate(view);
+                        }
+                        if (d->m_pipeline) {
+                            d->m_pipeline->add(toEnvelope(view));
+                            d->m_pipeline->notifyAll();
+                        } else if (nullptr != d->m_delegate) {
+                            d->m_delegate(toEnvelope(view));
+                        }
                     }
-                } catch (...) {} // LCOV_EXCL_LINE
-            }
+                }
+            } catch (...) {} // LCOV_EXCL_LINE
         }
     }
 }
@@ -14363,33 +15071,45 @@ inline std::string EnvelopeConverter::getProtoEncodedEnvelopeFromJSON(const std:
 #include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <thread>
 #include <utility>
 
-namespace cluon {
-
-inline IndexEntry::IndexEntry(const int64_t &sampleTimeStamp, const uint64_t &filePosition) noexcept
-    : m_sampleTimeStamp(sampleTimeStamp)
-    , m_filePosition(filePosition)
-    , m_available(false) {}
+// clang-format off
+#ifndef WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+// clang-format on
 
-////////////////////////////////////////////////////////////////////////
+namespace cluon {
 
 inline Player::Player(const std::string &file, const bool &autoRewind, const bool &threading) noexcept
     : m_threading(threading)
     , m_file(file)
+    , m_recFileData(nullptr)
+    , m_recFileSize(0)
+    , m_recFileModificationTime(UNKNOWN_MODIFICATION_TIME)
     , m_recFile()
+    , m_recFileBuffer()
     , m_recFileValid(false)
     , m_autoRewind(autoRewind)
     , m_indexMutex()
-    , m_index()
-    , m_previousPreviousEnvelopeAlreadyReplayed(m_index.end())
-    , m_previousEnvelopeAlreadyReplayed(m_index.begin())
-    , m_currentEnvelopeToReplay(m_index.begin())
-    , m_nextEntryToReadFromRecFile(m_index.begin())
+    , m_index(nullptr)
+    , m_indexSize(0)
+    , m_indexEntries()
+    , m_indexFileData(nullptr)
+    , m_indexFileSize(0)
+    , m_previousPreviousEnvelopeAlreadyReplayed(0)
+    , m_previousEnvelopeAlreadyReplayed(0)
+    , m_currentEnvelopeToReplay(0)
+    , m_nextEntryToReadFromRecFile(0)
     , m_desiredInitialLevel(0)
     , m_firstTimePointReturningAEnvelope()
     , m_numberOfReturnedEnvelopesInTotal(0)
@@ -14417,7 +15137,23 @@ inline Player::~Player() {
         m_envelopeCacheFillingThread.join();
     }
 
+#ifndef WIN32
+    if ((nullptr != m_recFileData) && (0 < m_recFileSize)) {
+        ::munmap(const_cast<char *>(m_recFileData), static_cast<std::size_t>(m_recFileSize));
+    }
+#endif
+    m_recFileData = nullptr;
+    m_recFileSize = 0;
     m_recFile.close();
+
+#ifndef WIN32
+    if (nullptr != m_indexFileData) {
+        ::munmap(m_indexFileData, m_indexFileSize);
+    }
+#endif
+    m_indexFileData = nullptr;
+    m_index         = nullptr;
+    m_indexSize     = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -14429,47 +15165,255 @@ inline void Player::setPlayerListener(std::function<void(cluon::data::PlayerStat
 
 ////////////////////////////////////////////////////////////////////////
 
-inline void Player::initializeIndex() noexcept {
+inline bool Player::openRecFile() noexcept {
+    if (mapRecFile()) {
+        return true;
+    }
+    // Reading through a stream is slower but also works where the file cannot be
+    // mapped, for example a recording of several GB in a 32-bit address space.
     m_recFile.open(m_file.c_str(), std::ios_base::in | std::ios_base::binary); /* Flawfinder: ignore */
-    m_recFileValid = m_recFile.good();
+    if (!m_recFile.good()) {
+        return false;
+    }
+    m_recFile.seekg(0, m_recFile.end);
+    const std::streamoff SIZE{m_recFile.tellg()};
+    m_recFile.seekg(0, m_recFile.beg);
+    if (!m_recFile.good() || (0 > SIZE)) {
+        m_recFile.close();
+        return false;
+    }
+    m_recFileSize = static_cast<uint64_t>(SIZE);
+    return true;
+}
 
-    if (m_recFileValid) {
-        // Determine file size to display progress.
-        m_recFile.seekg(0, m_recFile.end);
-        int64_t fileLength = m_recFile.tellg();
-        m_recFile.seekg(0, m_recFile.beg);
+inline bool Player::mapRecFile() noexcept {
+#ifdef WIN32
+    return false;
+#else
+    const int fd = ::open(m_file.c_str(), O_RDONLY); /* Flawfinder: ignore */
+    if (0 > fd) {
+        return false;
+    }
+    bool retVal{false};
+    struct stat fileStatus;
+    if (0 == ::fstat(fd, &fileStatus)) {
+#ifdef __APPLE__
+        m_recFileModificationTime = static_cast<int64_t>(fileStatus.st_mtimespec.tv_sec) * static_cast<int64_t>(1000 * 1000 * 1000) + fileStatus.st_mtimespec.tv_nsec;
+#else
+        m_recFileModificationTime = static_cast<int64_t>(fileStatus.st_mtim.tv_sec) * static_cast<int64_t>(1000 * 1000 * 1000) + fileStatus.st_mtim.tv_nsec;
+#endif
+        const uint64_t SIZE{static_cast<uint64_t>(fileStatus.st_size)};
+        if (0 == SIZE) {
+            // An empty file cannot be mapped but is a valid, empty recording.
+            m_recFileSize = 0;
+            retVal        = true;
+        } else if (SIZE <= static_cast<uint64_t>((std::numeric_limits<std::size_t>::max)())) {
+            void *ptr = ::mmap(nullptr, static_cast<std::size_t>(SIZE), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (MAP_FAILED != ptr) {
+                m_recFileData = static_cast<const char *>(ptr);
+                m_recFileSize = SIZE;
+                retVal        = true;
+            }
+        }
+    }
+    ::close(fd);
+    return retVal;
+#endif
+}
 
-        // Read complete file and store file positions to envelopes to create
-        // index of available data. The actual reading of Envelopes is deferred.
+inline const char *Player::recFileDataAt(const uint64_t &position, std::size_t &size) noexcept {
+    size = 0;
+    if (position >= m_recFileSize) {
+        return nullptr;
+    }
+    if (nullptr != m_recFileData) {
+        size = static_cast<std::size_t>(m_recFileSize - position);
+        return m_recFileData + position;
+    }
+
+    constexpr std::size_t OD4_HEADER_SIZE{5};
+    const uint64_t AVAILABLE{m_recFileSize - position};
+    try {
+        // Reset any fstream's error states.
+        m_recFile.clear();
+        m_recFile.seekg(static_cast<std::streamoff>(position));
+        m_recFileBuffer.resize(static_cast<std::size_t>((std::min<uint64_t>)(OD4_HEADER_SIZE, AVAILABLE)));
+        m_recFile.read(&m_recFileBuffer[0], static_cast<std::streamsize>(m_recFileBuffer.size()));
+        if (!m_recFile.good()) {
+            return nullptr;
+        }
+        if ((OD4_HEADER_SIZE == m_recFileBuffer.size()) && (0x0D == static_cast<uint8_t>(m_recFileBuffer[0]))
+            && (0xA4 == static_cast<uint8_t>(m_recFileBuffer[1]))) {
+            // Read the rest of the Envelope, as much of it as the file holds.
+            const uint64_t LENGTH{static_cast<uint64_t>(static_cast<uint8_t>(m_recFileBuffer[2])) | (static_cast<uint64_t>(static_cast<uint8_t>(m_recFileBuffer[3])) << 8)
+                                  | (static_cast<uint64_t>(static_cast<uint8_t>(m_recFileBuffer[4])) << 16)};
+            m_recFileBuffer.resize(static_cast<std::size_t>((std::min<uint64_t>)(OD4_HEADER_SIZE + LENGTH, AVAILABLE)));
+            m_recFile.read(&m_recFileBuffer[OD4_HEADER_SIZE], static_cast<std::streamsize>(m_recFileBuffer.size() - OD4_HEADER_SIZE));
+            if (!m_recFile.good()) {
+                return nullptr;
+            }
+        }
+    } catch (...) { // LCOV_EXCL_LINE
+        return nullptr; // LCOV_EXCL_LINE
+    }
+    size = m_recFileBuffer.size();
+    return m_recFileBuffer.data();
+}
+
+inline bool Player::loadIndexFile() noexcept {
+    bool retVal{false};
+#ifndef WIN32
+    if (UNKNOWN_MODIFICATION_TIME == m_recFileModificationTime) {
+        // Without the modification time, a stale index could not be told apart.
+        return retVal;
+    }
+    const std::string INDEX_FILE{m_file + ".idx"};
+    const int fd = ::open(INDEX_FILE.c_str(), O_RDONLY); /* Flawfinder: ignore */
+    if (0 > fd) {
+        return retVal;
+    }
+    struct stat fileStatus;
+    if ((0 == ::fstat(fd, &fileStatus)) && (sizeof(IndexFileHeader) <= static_cast<std::size_t>(fileStatus.st_size))) {
+        const std::size_t SIZE{static_cast<std::size_t>(fileStatus.st_size)};
+        void *ptr = ::mmap(nullptr, SIZE, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED != ptr) {
+            IndexFileHeader header;
+            std::memcpy(&header, ptr, sizeof(IndexFileHeader));
+            retVal = (0 == std::memcmp(header.magic, "CLUONIDX", sizeof(header.magic))) && (2 == header.version)
+                     && (sizeof(IndexFileEntry) == header.entrySize) && (m_recFileSize == header.recFileSize)
+                     && (m_recFileModificationTime == header.recFileModificationTime)
+                     && ((SIZE - sizeof(IndexFileHeader)) / sizeof(IndexFileEntry) == header.numberOfEntries)
+                     && ((SIZE - sizeof(IndexFileHeader)) % sizeof(IndexFileEntry) == 0);
+            if (retVal) {
+                // The entries were checked when the index was written and are replayed in place;
+                // the header already ties them to this .rec file, so none of them is touched here.
+                m_indexFileData = ptr;
+                m_indexFileSize = SIZE;
+                m_index         = reinterpret_cast<const IndexFileEntry *>(static_cast<const char *>(ptr) + sizeof(IndexFileHeader));
+                m_indexSize     = static_cast<std::size_t>(header.numberOfEntries);
+            } else {
+                ::munmap(ptr, SIZE);
+            }
+        }
+    }
+    ::close(fd);
+#endif
+    return retVal;
+}
+
+inline void Player::writeIndexFile() const noexcept {
+#ifndef WIN32
+    if (UNKNOWN_MODIFICATION_TIME == m_recFileModificationTime) {
+        return;
+    }
+    // Only an index in replay order that points into the .rec file is stored, so that loading can trust it.
+    auto bySampleTimeStamp = [](const IndexFileEntry &a, const IndexFileEntry &b) { return a.sampleTimeStamp < b.sampleTimeStamp; };
+    auto outsideRecFile    = [this](const IndexFileEntry &e) { return e.filePosition >= m_recFileSize; };
+    if (!std::is_sorted(m_index, m_index + m_indexSize, bySampleTimeStamp) || std::any_of(m_index, m_index + m_indexSize, outsideRecFile)) {
+        return;
+    }
+    IndexFileHeader header;
+    std::memset(&header, 0, sizeof(IndexFileHeader));
+    std::memcpy(header.magic, "CLUONIDX", sizeof(header.magic));
+    header.version                 = 2;
+    header.entrySize               = sizeof(IndexFileEntry);
+    header.recFileSize             = m_recFileSize;
+    header.recFileModificationTime = m_recFileModificationTime;
+    header.numberOfEntries         = m_indexSize;
+
+    // Write to a temporary file first so that concurrent Players never see a partial index.
+    const std::string INDEX_FILE{m_file + ".idx"};
+    const std::string TMP_FILE{INDEX_FILE + "." + std::to_string(::getpid())};
+    bool retVal{false};
+    try {
+        std::fstream indexFile(TMP_FILE.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc); /* Flawfinder: ignore */
+        if (indexFile.good()) {
+            indexFile.write(reinterpret_cast<const char *>(&header), sizeof(IndexFileHeader));
+            indexFile.write(reinterpret_cast<const char *>(m_index), static_cast<std::streamsize>(m_indexSize * sizeof(IndexFileEntry)));
+            indexFile.close();
+            retVal = !indexFile.fail() && (0 == std::rename(TMP_FILE.c_str(), INDEX_FILE.c_str()));
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    if (!retVal) {
+        // The index is only a cache; a read-only directory must not break replaying.
+        std::remove(TMP_FILE.c_str());
+        std::clog << "[cluon::Player]: Could not write index file " << INDEX_FILE << "." << std::endl;
+    }
+#endif
+}
+
+inline void Player::initializeIndex() noexcept {
+    m_recFileValid = openRecFile();
+
+    if (m_recFileValid && loadIndexFile()) {
+        std::clog << "[cluon::Player]: " << m_file << " contains " << m_indexSize << " entries; "
+                  << "loaded from " << m_file << ".idx." << std::endl;
+    } else if (m_recFileValid) {
+#ifndef WIN32
+        // The index is built front to back; later replay follows the sample time stamps.
+        if (nullptr != m_recFileData) {
+            ::madvise(const_cast<char *>(m_recFileData), static_cast<std::size_t>(m_recFileSize), MADV_SEQUENTIAL);
+        }
+#endif
+        // Walk through the complete file and store file positions to envelopes to
+        // create index of available data. The actual decoding of Envelopes is deferred.
         uint64_t totalBytesRead = 0;
         const cluon::data::TimeStamp BEFORE{cluon::time::now()};
         {
             int32_t oldPercentage = -1;
-            while (m_recFile.good()) {
-                const uint64_t POS_BEFORE = static_cast<uint64_t>(m_recFile.tellg());
-                auto retVal               = extractEnvelope(m_recFile);
-                const uint64_t POS_AFTER  = static_cast<uint64_t>(m_recFile.tellg());
-
-                if (!m_recFile.eof() && retVal.first) {
-                    totalBytesRead += (POS_AFTER - POS_BEFORE);
-
+            constexpr uint64_t OD4_HEADER_SIZE{5};
+            EnvelopeView view;
+            std::size_t size{0};
+            const char *data{nullptr};
+            while ((OD4_HEADER_SIZE <= (m_recFileSize - totalBytesRead)) && (nullptr != (data = recFileDataAt(totalBytesRead, size)))) {
+                if (parseEnvelope(data, size, view)) {
                     // Store mapping .rec file position --> index entry.
-                    const int64_t microseconds = cluon::time::toMicroseconds(retVal.second.sampleTimeStamp());
-                    m_index.emplace(std::make_pair(microseconds, IndexEntry(microseconds, POS_BEFORE)));
-
-                    const int32_t percentage = static_cast<int32_t>((static_cast<float>(m_recFile.tellg()) * 100.0f) / static_cast<float>(fileLength));
-                    if ((percentage % 5 == 0) && (percentage != oldPercentage)) {
-                        std::clog << "[cluon::Player]: Indexed " << percentage << "% from " << m_file << "." << std::endl;
-                        oldPercentage = percentage;
+                    try {
+                        m_indexEntries.push_back(IndexFileEntry{view.sampleTimeStampInMicroseconds(), totalBytesRead});
+                    } catch (...) { // LCOV_EXCL_LINE
+                        break;      // LCOV_EXCL_LINE
                     }
+                    totalBytesRead += view.length;
+                } else if ((0 < view.length) && (view.length <= size)) {
+                    // Skip an Envelope whose content could not be decoded.
+                    totalBytesRead += view.length;
+                } else if ((0 == view.length) && !((0x0D == static_cast<uint8_t>(data[0])) && (0xA4 == static_cast<uint8_t>(data[1])))) {
+                    // Skip a broken header like reading from the stream did before.
+                    totalBytesRead += OD4_HEADER_SIZE;
+                } else {
+                    // Truncated Envelope at the end of the file.
+                    break;
+                }
+
+                const int32_t percentage = static_cast<int32_t>((static_cast<float>(totalBytesRead) * 100.0f) / static_cast<float>(m_recFileSize));
+                if ((percentage % 5 == 0) && (percentage != oldPercentage)) {
+                    std::clog << "[cluon::Player]: Indexed " << percentage << "% from " << m_file << "." << std::endl;
+                    oldPercentage = percentage;
                 }
             }
         }
+        // Envelopes are usually recorded in order; a stable sort keeps equal time stamps in file order.
+        auto bySampleTimeStamp = [](const IndexFileEntry &a, const IndexFileEntry &b) { return a.sampleTimeStamp < b.sampleTimeStamp; };
+        if (!std::is_sorted(m_indexEntries.begin(), m_indexEntries.end(), bySampleTimeStamp)) {
+            std::stable_sort(m_indexEntries.begin(), m_indexEntries.end(), bySampleTimeStamp);
+        }
+        m_index     = m_indexEntries.data();
+        m_indexSize = m_indexEntries.size();
         const cluon::data::TimeStamp AFTER{cluon::time::now()};
 
-        std::clog << "[cluon::Player]: " << m_file << " contains " << m_index.size() << " entries; "
+#ifndef WIN32
+        if (nullptr != m_recFileData) {
+            ::madvise(const_cast<char *>(m_recFileData), static_cast<std::size_t>(m_recFileSize), MADV_NORMAL);
+        }
+#endif
+
+        std::clog << "[cluon::Player]: " << m_file << " contains " << m_indexSize << " entries; "
                   << "read " << totalBytesRead << " bytes "
                   << "in " << cluon::time::deltaInMicroseconds(AFTER, BEFORE) / static_cast<int64_t>(1000 * 1000) << "s." << std::endl;
+
+        if (0 < m_indexSize) {
+            writeIndexFile();
+        }
     } else {
         std::clog << "[cluon::Player]: " << m_file << " could not be opened." << std::endl;
     }
@@ -14488,23 +15432,20 @@ inline void Player::resetIterators() noexcept {
     try {
         std::lock_guard<std::mutex> lck(m_indexMutex);
         // Point to first entry in index.
-        m_nextEntryToReadFromRecFile = m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay = m_index.begin();
-        // Invalidate iterator for erasing entries point.
-        m_previousPreviousEnvelopeAlreadyReplayed = m_index.end();
+        m_nextEntryToReadFromRecFile = m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay = 0;
+        // Invalidate position for erasing entries point.
+        m_previousPreviousEnvelopeAlreadyReplayed = m_indexSize;
     } catch (...) {} // LCOV_EXCL_LINE
 }
 
 inline void Player::computeInitialCacheLevelAndFillCache() noexcept {
-    if (m_recFileValid && (m_index.size() > 0)) {
-        int64_t smallestSampleTimePoint = (std::numeric_limits<int64_t>::max)();
-        int64_t largestSampleTimePoint  = (std::numeric_limits<int64_t>::min)();
-        for (auto it = m_index.begin(); it != m_index.end(); it++) {
-            smallestSampleTimePoint = (std::min)(smallestSampleTimePoint, it->first);
-            largestSampleTimePoint  = (std::max)(largestSampleTimePoint, it->first);
-        }
+    if (m_recFileValid && (m_indexSize > 0)) {
+        // The index is sorted by sample time stamp.
+        const int64_t smallestSampleTimePoint = m_index[0].sampleTimeStamp;
+        const int64_t largestSampleTimePoint  = m_index[m_indexSize - 1].sampleTimeStamp;
 
         const uint32_t ENTRIES_TO_READ_PER_SECOND_FOR_REALTIME_REPLAY
-            = static_cast<uint32_t>(std::ceil(static_cast<float>(m_index.size()) * (static_cast<float>(Player::ONE_SECOND_IN_MICROSECONDS))
+            = static_cast<uint32_t>(std::ceil(static_cast<float>(m_indexSize) * (static_cast<float>(Player::ONE_SECOND_IN_MICROSECONDS))
                                               / static_cast<float>(largestSampleTimePoint - smallestSampleTimePoint)));
         m_desiredInitialLevel = (std::max<uint32_t>)(ENTRIES_TO_READ_PER_SECOND_FOR_REALTIME_REPLAY * Player::LOOK_AHEAD_IN_S, MIN_ENTRIES_FOR_LOOK_AHEAD);
 
@@ -14519,26 +15460,23 @@ inline void Player::computeInitialCacheLevelAndFillCache() noexcept {
 inline uint32_t Player::fillEnvelopeCache(const uint32_t &maxNumberOfEntriesToReadFromFile) noexcept {
     uint32_t entriesReadFromFile = 0;
     if (m_recFileValid && (maxNumberOfEntriesToReadFromFile > 0)) {
-        // Reset any fstream's error states.
-        m_recFile.clear();
-
-        while ((m_nextEntryToReadFromRecFile != m_index.end()) && (entriesReadFromFile < maxNumberOfEntriesToReadFromFile)) {
-            // Move to corresponding position in the .rec file.
-            m_recFile.seekg(static_cast<std::streamoff>(m_nextEntryToReadFromRecFile->second.m_filePosition));
-
-            // Read the corresponding cluon::data::Envelope.
-            auto retVal = extractEnvelope(m_recFile);
-            if (retVal.first) {
+        EnvelopeView view;
+        while ((m_nextEntryToReadFromRecFile < m_indexSize) && (entriesReadFromFile < maxNumberOfEntriesToReadFromFile)) {
+            // Parse the corresponding cluon::data::Envelope in place; only its payload is copied.
+            // An entry of a loaded index file that points outside the .rec file is skipped.
+            const uint64_t POSITION = m_index[m_nextEntryToReadFromRecFile].filePosition;
+            std::size_t size{0};
+            const char *data{(POSITION < m_recFileSize) ? recFileDataAt(POSITION, size) : nullptr};
+            if ((nullptr != data) && parseEnvelope(data, size, view)) {
                 // Store the envelope in the envelope cache.
                 try {
                     std::lock_guard<std::mutex> lck(m_indexMutex);
-                    m_nextEntryToReadFromRecFile->second.m_available
-                        = m_envelopeCache.emplace(std::make_pair(m_nextEntryToReadFromRecFile->second.m_filePosition, retVal.second)).second;
+                    m_envelopeCache.emplace(std::make_pair(POSITION, toEnvelope(view)));
                 } catch (...) {} // LCOV_EXCL_LINE
-
-                m_nextEntryToReadFromRecFile++;
-                entriesReadFromFile++;
             }
+
+            m_nextEntryToReadFromRecFile++;
+            entriesReadFromFile++;
         }
     }
 
@@ -14550,7 +15488,7 @@ inline std::pair<bool, cluon::data::Envelope> Player::getNextEnvelopeToBeReplaye
     cluon::data::Envelope envelopeToReturn;
 
     // If at "EOF", either throw exception or autorewind.
-    if (m_currentEnvelopeToReplay == m_index.end()) {
+    if (m_currentEnvelopeToReplay == m_indexSize) {
         if (!m_autoRewind) {
             return std::make_pair(hasEnvelopeToReturn, envelopeToReturn);
         } else {
@@ -14558,21 +15496,23 @@ inline std::pair<bool, cluon::data::Envelope> Player::getNextEnvelopeToBeReplaye
         }
     }
 
-    if (m_currentEnvelopeToReplay != m_index.end()) {
+    if (m_currentEnvelopeToReplay != m_indexSize) {
         checkAvailabilityOfNextEnvelopeToBeReplayed();
 
         try {
             {
                 std::lock_guard<std::mutex> lck(m_indexMutex);
 
-                cluon::data::Envelope &nextEnvelope = m_envelopeCache[m_currentEnvelopeToReplay->second.m_filePosition];
+                cluon::data::Envelope &nextEnvelope = m_envelopeCache[m_index[m_currentEnvelopeToReplay].filePosition];
                 envelopeToReturn                    = nextEnvelope;
 
-                m_delay = static_cast<uint32_t>(m_currentEnvelopeToReplay->first - m_previousEnvelopeAlreadyReplayed->first);
+                // A loaded index is trusted to be in replay order; should it not be, there is no delay instead of a huge one.
+                const int64_t DELTA{m_index[m_currentEnvelopeToReplay].sampleTimeStamp - m_index[m_previousEnvelopeAlreadyReplayed].sampleTimeStamp};
+                m_delay = (0 < DELTA) ? static_cast<uint32_t>((std::min<int64_t>)(DELTA, MAX_DELAY_IN_MICROSECONDS)) : 0;
 
                 // TODO: Delegate deleting into own thread.
-                if (m_previousPreviousEnvelopeAlreadyReplayed != m_index.end()) {
-                    auto it = m_envelopeCache.find(m_previousEnvelopeAlreadyReplayed->second.m_filePosition);
+                if (m_previousPreviousEnvelopeAlreadyReplayed != m_indexSize) {
+                    auto it = m_envelopeCache.find(m_index[m_previousEnvelopeAlreadyReplayed].filePosition);
                     if (it != m_envelopeCache.end()) {
                         m_envelopeCache.erase(it);
                     }
@@ -14618,7 +15558,7 @@ inline void Player::checkAvailabilityOfNextEnvelopeToBeReplayed() noexcept {
 
 inline uint32_t Player::totalNumberOfEnvelopesInRecFile() const noexcept {
     std::lock_guard<std::mutex> lck(m_indexMutex);
-    return static_cast<uint32_t>(m_index.size());
+    return static_cast<uint32_t>(m_indexSize);
 }
 
 inline uint32_t Player::delay() const noexcept {
@@ -14661,18 +15601,17 @@ inline void Player::seekTo(float ratio) noexcept {
         uint32_t numberOfEntriesInIndex = 0;
         try {
             std::lock_guard<std::mutex> lck(m_indexMutex);
-            numberOfEntriesInIndex = static_cast<uint32_t>(m_index.size());
+            numberOfEntriesInIndex = static_cast<uint32_t>(m_indexSize);
         } catch (...) {} // LCOV_EXCL_LINE
 
         // Fast forward.
         m_numberOfReturnedEnvelopesInTotal = 0;
         std::clog << "[cluon::Player]: Seeking to " << static_cast<float>(numberOfEntriesInIndex) * ratio << "/" << numberOfEntriesInIndex << std::endl;
-        if (0 < ratio) {
-            for (m_numberOfReturnedEnvelopesInTotal = 0;
-                 m_numberOfReturnedEnvelopesInTotal < static_cast<uint32_t>(static_cast<float>(numberOfEntriesInIndex) * ratio) - 1;
-                 m_numberOfReturnedEnvelopesInTotal++) {
-                m_currentEnvelopeToReplay++;
-            }
+        // Positions in the index are reached directly.
+        const uint32_t ENTRIES_TO_SKIP{static_cast<uint32_t>(static_cast<float>(numberOfEntriesInIndex) * ratio)};
+        if ((0 < ratio) && (0 < ENTRIES_TO_SKIP)) {
+            m_numberOfReturnedEnvelopesInTotal = ENTRIES_TO_SKIP - 1;
+            m_currentEnvelopeToReplay          = ENTRIES_TO_SKIP - 1;
         }
         try {
             std::lock_guard<std::mutex> lck(m_indexMutex);
@@ -14707,7 +15646,7 @@ inline bool Player::hasMoreDataFromRecFile() const noexcept {
     // File must be successfully opened AND
     //  the Player must be configured as m_autoRewind OR
     //  some entries are left to replay.
-    return (m_recFileValid && (m_autoRewind || (m_currentEnvelopeToReplay != m_index.end())));
+    return (m_recFileValid && (m_autoRewind || (m_currentEnvelopeToReplay != m_indexSize)));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -14749,7 +15688,7 @@ inline void Player::manageCache() noexcept {
                 // m_numberOfReturnedEnvelopesInTotal is modified in a different thread.
                 std::lock_guard<std::mutex> lck(m_indexMutex);
                 numberOfReturnedEnvelopesInTotal = m_numberOfReturnedEnvelopesInTotal;
-                totalNumberOfEnvelopes           = static_cast<uint32_t>(m_index.size());
+                totalNumberOfEnvelopes           = static_cast<uint32_t>(m_indexSize);
             } catch (...) {} // LCOV_EXCL_LINE
 
             try {
@@ -17235,6 +18174,164 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
 }
 #endif
 
+#ifndef PROTO_WIRE_FORMAT_FUNCTIONS
+#define PROTO_WIRE_FORMAT_FUNCTIONS
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+
+// Functions for the generated decode() and encode() methods that read and write the Proto wire format directly.
+inline bool protoReadVarInt(const char *&data, const char *end, uint64_t &value) noexcept {
+    value = 0;
+    for (uint32_t shift{0}; (data < end) && (shift < 64); shift += 7) {
+        const uint64_t C{static_cast<uint8_t>(*data++)};
+        value |= (C & 0x7f) << shift;
+        if (!(C & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool protoReadFixed32(const char *&data, const char *end, uint32_t &value) noexcept {
+    if (end - data < 4) {
+        return false;
+    }
+    const uint8_t *b{reinterpret_cast<const uint8_t*>(data)};
+    value = static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) | (static_cast<uint32_t>(b[2]) << 16) | (static_cast<uint32_t>(b[3]) << 24);
+    data += 4;
+    return true;
+}
+
+inline bool protoReadFixed64(const char *&data, const char *end, uint64_t &value) noexcept {
+    uint32_t low{0};
+    uint32_t high{0};
+    if (!protoReadFixed32(data, end, low) || !protoReadFixed32(data, end, high)) {
+        return false;
+    }
+    value = static_cast<uint64_t>(low) | (static_cast<uint64_t>(high) << 32);
+    return true;
+}
+
+inline bool protoReadFloat(const char *&data, const char *end, float &value) noexcept {
+    uint32_t v{0};
+    if (!protoReadFixed32(data, end, v)) {
+        return false;
+    }
+    std::memcpy(&value, &v, sizeof(float));
+    return true;
+}
+
+inline bool protoReadDouble(const char *&data, const char *end, double &value) noexcept {
+    uint64_t v{0};
+    if (!protoReadFixed64(data, end, v)) {
+        return false;
+    }
+    std::memcpy(&value, &v, sizeof(double));
+    return true;
+}
+
+inline bool protoReadLengthDelimited(const char *&data, const char *end, const char *&value, std::size_t &length) noexcept {
+    uint64_t v{0};
+    if (!protoReadVarInt(data, end, v) || (static_cast<uint64_t>(end - data) < v)) {
+        return false;
+    }
+    value = data;
+    length = static_cast<std::size_t>(v);
+    data += length;
+    return true;
+}
+
+inline bool protoSkipField(const char *&data, const char *end, uint64_t key) noexcept {
+    uint64_t v{0};
+    uint32_t w{0};
+    const char *value{nullptr};
+    std::size_t length{0};
+    switch (key & 0x7) {
+        case 0: return protoReadVarInt(data, end, v);
+        case 1: return protoReadFixed64(data, end, v);
+        case 2: return protoReadLengthDelimited(data, end, value, length);
+        case 5: return protoReadFixed32(data, end, w);
+        default: return false;
+    }
+}
+
+inline int64_t protoFromZigZag(uint64_t v) noexcept {
+    return static_cast<int64_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+inline uint64_t protoToZigZag(int64_t v) noexcept {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline constexpr std::size_t protoVarIntSize(uint64_t v) noexcept {
+    return (v < 0x80) ? 1 : 1 + protoVarIntSize(v >> 7);
+}
+
+inline char *protoWriteVarInt(char *buffer, uint64_t v) noexcept {
+    while (0x7f < v) {
+        *buffer++ = static_cast<char>((v & 0x7f) | 0x80);
+        v >>= 7;
+    }
+    *buffer++ = static_cast<char>(v);
+    return buffer;
+}
+
+inline char *protoWriteFixed32(char *buffer, uint32_t v) noexcept {
+    for (uint32_t i{0}; i < 4; i++) {
+        *buffer++ = static_cast<char>((v >> (8 * i)) & 0xff);
+    }
+    return buffer;
+}
+
+inline char *protoWriteFixed64(char *buffer, uint64_t v) noexcept {
+    buffer = protoWriteFixed32(buffer, static_cast<uint32_t>(v & 0xffffffff));
+    return protoWriteFixed32(buffer, static_cast<uint32_t>(v >> 32));
+}
+
+inline char *protoWriteFloat(char *buffer, float value) noexcept {
+    uint32_t v{0};
+    std::memcpy(&v, &value, sizeof(float));
+    return protoWriteFixed32(buffer, v);
+}
+
+inline char *protoWriteDouble(char *buffer, double value) noexcept {
+    uint64_t v{0};
+    std::memcpy(&v, &value, sizeof(double));
+    return protoWriteFixed64(buffer, v);
+}
+
+inline char *protoWriteLengthDelimited(char *buffer, const char *value, std::size_t length) noexcept {
+    buffer = protoWriteVarInt(buffer, length);
+    if (0 < length) {
+        std::memcpy(buffer, value, length);
+    }
+    return buffer + length;
+}
+
+// MaxEncodedSize() of a field or message without an upper bound (string, bytes), as 0 is that of a message without fields.
+constexpr std::size_t PROTO_UNBOUNDED_SIZE{(std::numeric_limits<std::size_t>::max)()};
+
+// Largest encoded size of a message from the largest encoded sizes of its fields; PROTO_UNBOUNDED_SIZE if one of them has no upper bound.
+inline constexpr std::size_t protoMaxEncodedSize(std::initializer_list<std::size_t> fields) noexcept {
+    std::size_t size{0};
+    for (const std::size_t field : fields) {
+        if (PROTO_UNBOUNDED_SIZE == field) {
+            return PROTO_UNBOUNDED_SIZE;
+        }
+        size += field;
+    }
+    return size;
+}
+
+// Largest encoded size of a field holding a nested message; PROTO_UNBOUNDED_SIZE if the nested message has no upper bound.
+inline constexpr std::size_t protoMaxEncodedSizeOfMessage(std::size_t keySize, std::size_t messageSize) noexcept {
+    return (PROTO_UNBOUNDED_SIZE == messageSize) ? PROTO_UNBOUNDED_SIZE : keySize + protoVarIntSize(messageSize) + messageSize;
+}
+#endif
+
 
 #ifndef {{%HEADER_GUARD%}}_HPP
 #define {{%HEADER_GUARD%}}_HPP
@@ -17256,6 +18353,8 @@ void doTripletForwardVisit(uint32_t fieldIdentifier, std::string &&typeName, std
     #define LIB_API
 #endif
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
 {{%NAMESPACE_OPENING%}}
@@ -17295,6 +18394,71 @@ class LIB_API {{%MESSAGE%}} {
         }
         {{/%FIELDS%}}
 
+    public:
+        /**
+         * @return Largest number of bytes encode() writes, or PROTO_UNBOUNDED_SIZE
+         *         if a field of this message (string, bytes) has no upper bound.
+         */
+        inline static constexpr std::size_t MaxEncodedSize() noexcept {
+            return protoMaxEncodedSize({ {{#%FIELDS%}}{{%MAX_ENCODED_SIZE%}}, {{/%FIELDS%}}});
+        }
+
+        /**
+         * @return Number of bytes encode() writes for the current values.
+         */
+        inline std::size_t encodedSize() const noexcept {
+            std::size_t size{0};
+            {{#%FIELDS%}}
+            size += {{%ENCODED_SIZE%}};
+            {{/%FIELDS%}}
+            return size;
+        }
+
+        /**
+         * This method decodes the Proto-encoded bytes [data, data + size)
+         * directly into the fields of this message; unknown fields are
+         * skipped and fields not present keep their values.
+         *
+         * @return true if all bytes could be decoded.
+         */
+        inline bool decode(const char *data, std::size_t size) noexcept {
+            const char *end{data + size};
+            while (data < end) {
+                uint64_t key{0};
+                if (!protoReadVarInt(data, end, key)) {
+                    return false;
+                }
+                switch (key) {
+                    {{#%FIELDS%}}
+                    case {{%KEY%}}: // {{%NAME%}}
+                    {
+                        {{%DECODE%}}
+                    }
+                    break;
+                    {{/%FIELDS%}}
+                    default:
+                        if (!protoSkipField(data, end, key)) {
+                            return false;
+                        }
+                }
+            }
+            return true;
+        }
+
+        /**
+         * This method encodes this message in Proto format into buffer,
+         * which must hold at least encodedSize() bytes.
+         *
+         * @return Number of bytes written.
+         */
+        inline std::size_t encode(char *buffer) const noexcept {
+            char *data{buffer};
+            {{#%FIELDS%}}
+            {{%ENCODE%}}
+            {{/%FIELDS%}}
+            return static_cast<std::size_t>(data - buffer);
+        }
+
     public:
         template<class Visitor>
         inline void accept(uint32_t fieldId, Visitor &visitor) {
@@ -17428,6 +18592,7 @@ void MetaMessageToCPPTransformator::visit(const MetaMessage &mm) noexcept {
             std::string fieldName{std::regex_replace(e.fieldName(), std::regex("\\."), "_")}; // NOLINT
             kainjow::mustache::data fieldEntry;
             fieldEntry.set("%NAME%", fieldName);
+            std::string messageType;
             if (MetaMessage::MetaField::MESSAGE_T != e.fieldDataType()) {
                 fieldEntry.set("%TYPE%", typeToTypeStringMap[e.fieldDataType()]);
 
@@ -17447,9 +18612,99 @@ void MetaMessageToCPPTransformator::visit(const MetaMessage &mm) noexcept {
                 const std::string completeDataTypeNameWithDoubleColons{std::regex_replace(tmp, std::regex("\\."), "::")}; // NOLINT
 
                 fieldEntry.set("%TYPE%", completeDataTypeNameWithDoubleColons);
+                messageType = completeDataTypeNameWithDoubleColons;
             }
             fieldEntry.set("%FIELDIDENTIFIER%", std::to_string(e.fieldIdentifier()));
 
+            // Snippets for the generated decode() and encode() methods.
+            const std::string member{"m_" + fieldName};
+            const std::string nextLine{"\n                        "};
+            const std::string returnFalse{" {" + nextLine + "    return false;" + nextLine + "}"};
+            uint64_t protoType{0};
+            std::string decode;
+            std::string encode;
+            std::string encodedValueSize;
+            std::string maxEncodedValueSize{"PROTO_UNBOUNDED_SIZE"};
+            switch (e.fieldDataType()) {
+                case MetaMessage::MetaField::FLOAT_T:
+                case MetaMessage::MetaField::DOUBLE_T:
+                {
+                    const bool isFloat{MetaMessage::MetaField::FLOAT_T == e.fieldDataType()};
+                    protoType           = (isFloat ? 5 : 1);
+                    decode              = "if (!protoRead" + std::string(isFloat ? "Float" : "Double") + "(data, end, " + member + "))" + returnFalse;
+                    encode              = "data = protoWrite" + std::string(isFloat ? "Float" : "Double") + "(data, " + member + ");";
+                    encodedValueSize    = (isFloat ? "4" : "8");
+                    maxEncodedValueSize = encodedValueSize;
+                }
+                break;
+                case MetaMessage::MetaField::STRING_T:
+                case MetaMessage::MetaField::BYTES_T:
+                {
+                    protoType        = 2;
+                    decode           = "const char *value{nullptr};" + nextLine + "std::size_t length{0};" + nextLine
+                             + "if (!protoReadLengthDelimited(data, end, value, length))" + returnFalse + nextLine + member + ".assign(value, length);";
+                    encode           = "data = protoWriteLengthDelimited(data, " + member + ".data(), " + member + ".size());";
+                    encodedValueSize = "protoVarIntSize(" + member + ".size()) + " + member + ".size()";
+                }
+                break;
+                case MetaMessage::MetaField::MESSAGE_T:
+                {
+                    protoType        = 2;
+                    decode           = "const char *value{nullptr};" + nextLine + "std::size_t length{0};" + nextLine
+                             + "if (!protoReadLengthDelimited(data, end, value, length) || !" + member + ".decode(value, length))" + returnFalse;
+                    encode           = "data = protoWriteVarInt(data, " + member + ".encodedSize());\n            data += " + member + ".encode(data);";
+                    encodedValueSize = "protoVarIntSize(" + member + ".encodedSize()) + " + member + ".encodedSize()";
+                }
+                break;
+                default:
+                {
+                    // All other types are VarInts; signed types are ZigZag-encoded like in ToProtoVisitor.
+                    const bool isSigned{(MetaMessage::MetaField::INT8_T == e.fieldDataType()) || (MetaMessage::MetaField::INT16_T == e.fieldDataType())
+                                        || (MetaMessage::MetaField::INT32_T == e.fieldDataType()) || (MetaMessage::MetaField::INT64_T == e.fieldDataType())};
+                    const std::string TYPE{typeToTypeStringMap[e.fieldDataType()]};
+                    std::string fromVarInt{"static_cast<" + TYPE + ">(" + std::string(isSigned ? "protoFromZigZag(value)" : "value") + ")"};
+                    std::string toVarInt{isSigned ? "protoToZigZag(" + member + ")" : member};
+                    if (MetaMessage::MetaField::BOOL_T == e.fieldDataType()) {
+                        fromVarInt = "(0 != value)";
+                        toVarInt   = "(" + member + " ? 1u : 0u)";
+                    } else if (MetaMessage::MetaField::CHAR_T == e.fieldDataType()) {
+                        toVarInt = "static_cast<uint8_t>(" + member + ")";
+                    }
+                    std::map<MetaMessage::MetaField::MetaFieldDataTypes, std::string> maxVarIntSize = {
+                        {MetaMessage::MetaField::BOOL_T, "1"},
+                        {MetaMessage::MetaField::CHAR_T, "2"},
+                        {MetaMessage::MetaField::UINT8_T, "2"},
+                        {MetaMessage::MetaField::INT8_T, "2"},
+                        {MetaMessage::MetaField::UINT16_T, "3"},
+                        {MetaMessage::MetaField::INT16_T, "3"},
+                        {MetaMessage::MetaField::UINT32_T, "5"},
+                        {MetaMessage::MetaField::INT32_T, "5"},
+                        {MetaMessage::MetaField::UINT64_T, "10"},
+                        {MetaMessage::MetaField::INT64_T, "10"},
+                    };
+                    protoType           = 0;
+                    decode              = "uint64_t value{0};" + nextLine + "if (!protoReadVarInt(data, end, value))" + returnFalse + nextLine + member + " = " + fromVarInt + ";";
+                    encode              = "data = protoWriteVarInt(data, " + toVarInt + ");";
+                    encodedValueSize    = "protoVarIntSize(" + toVarInt + ")";
+                    maxEncodedValueSize = maxVarIntSize[e.fieldDataType()];
+                }
+                break;
+            }
+            const uint64_t key{(static_cast<uint64_t>(e.fieldIdentifier()) << 3) | protoType};
+            std::size_t keySize{1};
+            for (uint64_t v{key}; 0x7f < v; v >>= 7) {
+                keySize++;
+            }
+            fieldEntry.set("%KEY%", std::to_string(key));
+            fieldEntry.set("%DECODE%", decode);
+            fieldEntry.set("%ENCODE%", "data = protoWriteVarInt(data, " + std::to_string(key) + ");\n            " + encode);
+            fieldEntry.set("%ENCODED_SIZE%", std::to_string(keySize) + " + " + encodedValueSize);
+            if (MetaMessage::MetaField::MESSAGE_T == e.fieldDataType()) {
+                fieldEntry.set("%MAX_ENCODED_SIZE%", "protoMaxEncodedSizeOfMessage(" + std::to_string(keySize) + ", " + messageType + "::MaxEncodedSize())");
+            } else {
+                fieldEntry.set("%MAX_ENCODED_SIZE%", ("PROTO_UNBOUNDED_SIZE" == maxEncodedValueSize) ? maxEncodedValueSize : std::to_string(keySize) + " + " + maxEncodedValueSize);
+            }
+
             fields.push_back(fieldEntry);
         }
     } catch (std::regex_error &) { // LCOV_EXCL_LINE
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cone-classifier.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+constexpr uint32_t ConeColourClassifier::MIN_BITS_PER_CHANNEL;
+constexpr uint32_t ConeColourClassifier::MAX_BITS_PER_CHANNEL;
+
+bool parseSegmentationMethod(const std::string &name, SegmentationMethod &method)
+{
+    if ("hsv" == name)
+    {
+        method = SegmentationMethod::Hsv;
+    }
+    else if ("lut" == name)
+    {
+        method = SegmentationMethod::Lut;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+bool parseLookupTableBits(const std::string &text, uint32_t &bits)
+{
+    size_t parsed{0};
+    int32_t value{0};
+    try
+    {
+        value = std::stoi(text, &parsed);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    if ((parsed != text.size()) || (value < static_cast<int32_t>(ConeColourClassifier::MIN_BITS_PER_CHANNEL)) ||
+        (value > static_cast<int32_t>(ConeColourClassifier::MAX_BITS_PER_CHANNEL)))
+    {
+        return false;
+    }
+    bits = static_cast<uint32_t>(value);
+    return true;
+}
+
+ConeColourClassifier::ConeColourClassifier(uint32_t bitsPerChannel, const ConeColourThresholds &thresholds)
+    : m_bits{std::min(std::max(bitsPerChannel, MIN_BITS_PER_CHANNEL), MAX_BITS_PER_CHANNEL)}
+    , m_shift{8 - m_bits}
+    , m_thresholds{thresholds}
+{
+    rebuild();
+}
+
+bool ConeColourClassifier::setThresholds(const ConeColourThresholds &thresholds)
+{
+    if (thresholds == m_thresholds)
+    {
+        return false;
+    }
+    m_thresholds = thresholds;
+    rebuild();
+    return true;
+}
+
+const ConeColourThresholds &ConeColourClassifier::thresholds() const noexcept
+{
+    return m_thresholds;
+}
+
+uint32_t ConeColourClassifier::bitsPerChannel() const noexcept
+{
+    return m_bits;
+}
+
+size_t ConeColourClassifier::tableSize() const noexcept
+{
+    return m_table.size();
+}
+
+uint32_t ConeColourClassifier::index(uint32_t b, uint32_t g, uint32_t r) const noexcept
+{
+    return ((b >> m_shift) << (2 * m_bits)) | ((g >> m_shift) << m_bits) | (r >> m_shift);
+}
+
+void ConeColourClassifier::rebuild()
+{
+    const size_t cells{size_t{1} << (3 * m_bits)};
+    m_table.assign(cells, CONE_NONE);
+
+    // Count how many of the colours falling into each cell match either range.
+    // At 8 bits per channel every cell holds exactly one colour.
+    std::vector<uint16_t> blueVotes(cells, 0);
+    std::vector<uint16_t> yellowVotes(cells, 0);
+    uint8_t pixel[4]{0, 0, 0, 0};
+    for (uint32_t b{0}; b < 256; b++)
+    {
+        for (uint32_t g{0}; g < 256; g++)
+        {
+            for (uint32_t r{0}; r < 256; r++)
+            {
+                pixel[0] = static_cast<uint8_t>(b);
+                pixel[1] = static_cast<uint8_t>(g);
+                pixel[2] = static_cast<uint8_t>(r);
+                uint8_t h, s, v;
+                bgraToHsv(pixel, h, s, v);
+                const uint32_t i{index(b, g, r)};
+                blueVotes[i] = static_cast<uint16_t>(blueVotes[i] + (isInside(m_thresholds.blue, h, s, v) ? 1 : 0));
+                yellowVotes[i] = static_cast<uint16_t>(yellowVotes[i] + (isInside(m_thresholds.yellow, h, s, v) ? 1 : 0));
+            }
+        }
+    }
+
+    const uint32_t coloursPerCell{1u << (3 * m_shift)};
+    for (size_t i{0}; i < cells; i++)
+    {
+        m_table[i] = static_cast<uint8_t>(((2u * blueVotes[i] > coloursPerCell) ? CONE_BLUE : CONE_NONE) |
+                                          ((2u * yellowVotes[i] > coloursPerCell) ? CONE_YELLOW : CONE_NONE));
+    }
+}
+
+uint8_t ConeColourClassifier::classify(uint8_t b, uint8_t g, uint8_t r) const noexcept
+{
+    return m_table[index(b, g, r)];
+}
+
+void ConeColourClassifier::segment(const uint8_t *bgra, size_t bgraStride, uint32_t width, uint32_t height, uint8_t *blueMask, uint8_t *yellowMask,
+                                   size_t maskStride) const noexcept
+{
+    const uint8_t *table{m_table.data()};
+    for (uint32_t y{0}; y < height; y++)
+    {
+        const uint8_t *row{bgra + y * bgraStride};
+        uint8_t *blueRow{blueMask + y * maskStride};
+        uint8_t *yellowRow{yellowMask + y * maskStride};
+        for (uint32_t x{0}; x < width; x++)
+        {
+            const uint8_t *p{row + 4 * x};
+            const uint8_t cls{table[index(p[0], p[1], p[2])]};
+            blueRow[x] = (cls & CONE_BLUE) ? 255 : 0;
+            yellowRow[x] = (cls & CONE_YELLOW) ? 255 : 0;
+        }
+    }
+}
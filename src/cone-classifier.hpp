@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONE_CLASSIFIER_HPP
+#define CONE_CLASSIFIER_HPP
+
+#include "hsv-threshold.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Bit flags stored per table entry; a colour may match both ranges if they overlap.
+enum ConeClass : uint8_t
+{
+    CONE_NONE = 0,
+    CONE_BLUE = 1,
+    CONE_YELLOW = 2
+};
+
+// How the cone masks are segmented.
+enum class SegmentationMethod
+{
+    Hsv, // Fused HSV conversion and thresholding.
+    Lut  // Lookup table precomputed from the HSV thresholds.
+};
+
+// Parse "hsv" or "lut"; returns false for anything else.
+bool parseSegmentationMethod(const std::string &name, SegmentationMethod &method);
+
+// Parse the bits per channel of the lookup table; returns false for anything but a
+// number in [ConeColourClassifier::MIN_BITS_PER_CHANNEL, ConeColourClassifier::MAX_BITS_PER_CHANNEL].
+bool parseLookupTableBits(const std::string &text, uint32_t &bits);
+
+// Classifies BGRA pixels into cone colours with a single lookup into a table
+// precomputed from the HSV thresholds, so segmentation needs no HSV conversion.
+// With fewer than 8 bits per channel each table cell covers several colours and
+// takes the class that the majority of them has; 6 bits give a 256 kB table that
+// stays in L2 cache, 5 bits a 32 kB one.
+class ConeColourClassifier
+{
+  public:
+    static constexpr uint32_t MIN_BITS_PER_CHANNEL{4};
+    static constexpr uint32_t MAX_BITS_PER_CHANNEL{8};
+
+    // bitsPerChannel is clamped to [MIN_BITS_PER_CHANNEL, MAX_BITS_PER_CHANNEL].
+    explicit ConeColourClassifier(uint32_t bitsPerChannel = 6, const ConeColourThresholds &thresholds = ConeColourThresholds{});
+
+    // Rebuild the table if the thresholds differ from the current ones; returns true when it was rebuilt.
+    bool setThresholds(const ConeColourThresholds &thresholds);
+    const ConeColourThresholds &thresholds() const noexcept;
+    uint32_t bitsPerChannel() const noexcept;
+    size_t tableSize() const noexcept;
+
+    uint8_t classify(uint8_t b, uint8_t g, uint8_t r) const noexcept;
+
+    // Drop-in alternative to thresholdCones() with the same buffer layout.
+    void segment(const uint8_t *bgra, size_t bgraStride, uint32_t width, uint32_t height, uint8_t *blueMask, uint8_t *yellowMask, size_t maskStride) const noexcept;
+
+  private:
+    uint32_t index(uint32_t b, uint32_t g, uint32_t r) const noexcept;
+    void rebuild();
+
+  private:
+    uint32_t m_bits;
+    uint32_t m_shift;
+    ConeColourThresholds m_thresholds;
+    std::vector<uint8_t> m_table{};
+};
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cone-detection.hpp"
+
+namespace
+{
+// Dividing the frame into two halves of 325 x 500 pixels.
+constexpr int32_t HALF_WIDTH{325};
+constexpr int32_t REGION_HEIGHT{500};
+
+struct Detected
+{
+    bool left;
+    bool right;
+};
+
+Detected sides(const std::vector<Blob> &blobs) noexcept
+{
+    Detected detected{false, false};
+    // The first blob seen decides the side of a colour. findContours handed out its
+    // contours in reverse order of their first pixel in raster order, so the blobs are
+    // visited from the last to the first to keep that decision.
+    for (auto it = blobs.rbegin(); it != blobs.rend(); ++it)
+    {
+        const Blob &blob{*it};
+        const int32_t x{static_cast<int32_t>(blob.centroidX())};
+        const int32_t y{static_cast<int32_t>(blob.centroidY())};
+        if ((0 > y) || (REGION_HEIGHT <= y))
+        {
+            continue;
+        }
+
+        // Check if the centroid is in the left region and cones are not detected on the right side
+        if ((0 <= x) && (x < HALF_WIDTH) && !detected.right)
+        {
+            detected.left = true;
+        }
+        else if ((HALF_WIDTH <= x) && (x < 2 * HALF_WIDTH) && !detected.left)
+        {
+            detected.right = true;
+        }
+    }
+    return detected;
+}
+} // namespace
+
+ConeSides detectConeSides(const std::vector<Blob> &blueBlobs, const std::vector<Blob> &yellowBlobs) noexcept
+{
+    const Detected blue{sides(blueBlobs)};
+    const Detected yellow{sides(yellowBlobs)};
+    return ConeSides{blue.left || yellow.left, blue.right || yellow.right};
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONE_DETECTION_HPP
+#define CONE_DETECTION_HPP
+
+#include "blob-extraction.hpp"
+
+#include <vector>
+
+// Whether cones were seen in the left and in the right half of the frame.
+struct ConeSides
+{
+    bool leftCone;
+    bool rightCone;
+};
+
+// Sort the blobs of both colours into the left (x < 325) and right half of the frame
+// by their centroid. Once a colour has been seen on one side, further blobs of that
+// colour do not count for the other side. Blobs must be in raster order of their first
+// pixel, as BlobExtractor and BandedPerception return them; they are visited in the
+// order cv::findContours returned the outer contours before.
+ConeSides detectConeSides(const std::vector<Blob> &blueBlobs, const std::vector<Blob> &yellowBlobs) noexcept;
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cone-perception.hpp"
+
+void segmentCones(const cv::Mat &frame, const RegionOfInterest &roi, const ConeColourThresholds &thresholds, const ConeColourClassifier *classifier,
+                  FrameWorkspace &ws) noexcept
+{
+    const uint8_t *bgra{frame.ptr<uint8_t>(roi.y) + 4 * roi.x};
+    uint8_t *blue{ws.blueMask.ptr<uint8_t>(roi.y) + roi.x};
+    uint8_t *yellow{ws.yellowMask.ptr<uint8_t>(roi.y) + roi.x};
+    if (nullptr != classifier)
+    {
+        classifier->segment(bgra, frame.step, static_cast<uint32_t>(roi.width), static_cast<uint32_t>(roi.height), blue, yellow, ws.blueMask.step);
+    }
+    else
+    {
+        thresholdCones(bgra, frame.step, static_cast<uint32_t>(roi.width), static_cast<uint32_t>(roi.height), thresholds, blue, yellow, ws.blueMask.step);
+    }
+}
+
+void findConeBlobs(FrameWorkspace &ws)
+{
+    // Used for removing smaller noises and merging larger detected objects; both masks are
+    // bit-packed side by side and opened/closed together.
+    const RegionOfInterest &region{ws.maskRegion};
+    ws.coneMasks.pack(0, ws.blueMask.ptr<uint8_t>(region.y) + region.x, ws.blueMask.step);
+    ws.coneMasks.pack(1, ws.yellowMask.ptr<uint8_t>(region.y) + region.x, ws.yellowMask.step);
+    ws.coneMasks.open(MERGE_RADIUS);
+    ws.coneMasks.close(CLOSE_RADIUS);
+
+    // Finding the blue and yellow blobs with their area, centroid and bounding box straight from the packed masks
+    ws.blobExtractor.extract(ws.coneMasks, 0, region.x, region.y, ws.blueBlobs);
+    ws.blobExtractor.extract(ws.coneMasks, 1, region.x, region.y, ws.yellowBlobs);
+}
+
+double steerFromBlobs(const FrameWorkspace &ws, const YawRateState &yawRate, const SteeringParameters &parameters) noexcept
+{
+    const ConeSides cones{detectConeSides(ws.blueBlobs, ws.yellowBlobs)};
+    return checkSteering(cones.leftCone, cones.rightCone, yawRate.value, yawRate.derivative, parameters);
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONE_PERCEPTION_HPP
+#define CONE_PERCEPTION_HPP
+
+#include "cone-classifier.hpp"
+#include "cone-detection.hpp"
+#include "frame-workspace.hpp"
+#include "hsv-threshold.hpp"
+#include "region-of-interest.hpp"
+#include "steering-algorithm.hpp"
+#include "yaw-rate-state.hpp"
+
+#include <opencv2/core/core.hpp>
+
+// Segment the region of interest of an ARGB frame into the blue and yellow masks of
+// ws, with the lookup table if a classifier is given and the fused HSV kernel otherwise.
+void segmentCones(const cv::Mat &frame, const RegionOfInterest &roi, const ConeColourThresholds &thresholds, const ConeColourClassifier *classifier,
+                  FrameWorkspace &ws) noexcept;
+
+// Open and close the cone masks of ws and extract the blue and yellow blobs.
+void findConeBlobs(FrameWorkspace &ws);
+
+// Sort the blobs of ws into the left and right half of the frame and steer for them.
+double steerFromBlobs(const FrameWorkspace &ws, const YawRateState &yawRate, const SteeringParameters &parameters = DEFAULT_STEERING_PARAMETERS) noexcept;
+
+#endif
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "frame-acquisition.hpp"
+
+bool parseAcquisitionMode(const std::string &name, AcquisitionMode &mode)
+{
+    if ("copy" == name)
+    {
+        mode = AcquisitionMode::Copy;
+    }
+    else if ("direct" == name)
+    {
+        mode = AcquisitionMode::Direct;
+    }
+    else if ("ring" == name)
+    {
+        mode = AcquisitionMode::Ring;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+FrameAcquisition::FrameAcquisition(cluon::SharedMemory &sharedMemory, uint32_t width, uint32_t height, AcquisitionMode mode, uint32_t ringSize)
+    : m_sharedMemory{sharedMemory}
+    , m_width{width}
+    , m_height{height}
+    , m_mode{mode}
+    , m_roi{clipRegionOfInterest(CONE_REGION_OF_INTEREST, width, height)}
+{
+    // Ring buffers are zeroed once; afterwards only the region of interest is ever written.
+    const uint32_t buffers{(AcquisitionMode::Ring == m_mode) ? std::max<uint32_t>(ringSize, 1) : 1};
+    for (uint32_t i{0}; i < buffers; i++)
+    {
+        m_buffers.emplace_back(cv::Mat::zeros(static_cast<int>(m_height), static_cast<int>(m_width), CV_8UC4));
+    }
+}
+
+const cv::Mat &FrameAcquisition::acquire()
+{
+    // Wait for a notification of a new frame.
+    m_sharedMemory.wait();
+
+    m_sharedMemory.lock();
+    m_lockedAt = std::chrono::steady_clock::now();
+    m_locked = true;
+
+    cv::Mat wrapped(static_cast<int>(m_height), static_cast<int>(m_width), CV_8UC4, m_sharedMemory.data());
+    if (AcquisitionMode::Copy == m_mode)
+    {
+        wrapped.copyTo(m_buffers[0]);
+        m_frame = m_buffers[0];
+    }
+    else if (AcquisitionMode::Ring == m_mode)
+    {
+        const cv::Rect roi(m_roi.x, m_roi.y, m_roi.width, m_roi.height);
+        cv::Mat destination{m_buffers[m_next](roi)};
+        wrapped(roi).copyTo(destination);
+        m_frame = m_buffers[m_next];
+        m_next = (m_next + 1) % static_cast<uint32_t>(m_buffers.size());
+    }
+    else
+    {
+        m_frame = wrapped;
+    }
+
+    m_sampleTimeStamp = cluon::time::toMicroseconds(m_sharedMemory.getTimeStamp().second);
+
+    // Only Direct mode keeps the producer waiting while the frame is processed.
+    if (AcquisitionMode::Direct != m_mode)
+    {
+        unlock();
+    }
+    return m_frame;
+}
+
+void FrameAcquisition::release()
+{
+    if (m_locked)
+    {
+        // Drop the alias into the shared memory before handing it back to the producer.
+        m_frame = cv::Mat();
+        unlock();
+    }
+}
+
+void FrameAcquisition::interrupt() noexcept
+{
+    m_sharedMemory.notifyAll();
+}
+
+void FrameAcquisition::unlock()
+{
+    m_sharedMemory.unlock();
+    m_locked = false;
+    m_lockHoldMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_lockedAt).count();
+}
+
+AcquisitionMode FrameAcquisition::mode() const noexcept
+{
+    return m_mode;
+}
+
+const RegionOfInterest &FrameAcquisition::regionOfInterest() const noexcept
+{
+    return m_roi;
+}
+
+int64_t FrameAcquisition::sampleTimeStamp() const noexcept
+{
+    return m_sampleTimeStamp;
+}
+
+int64_t FrameAcquisition::lockHoldMicroseconds() const noexcept
+{
+    return m_lockHoldMicroseconds;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_ACQUISITION_HPP
+#define FRAME_ACQUISITION_HPP
+
+#include "cluon-complete.hpp"
+#include "region-of-interest.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// How frames are taken out of the shared memory area.
+enum class AcquisitionMode
+{
+    Copy,   // Clone the whole frame while the shared memory is locked.
+    Direct, // Read the region of interest straight from the locked shared memory; unlock on release().
+    Ring    // Copy only the region of interest into the next one of a ring of pre-zeroed buffers.
+};
+
+// Parse "copy", "direct" or "ring"; returns false for anything else.
+bool parseAcquisitionMode(const std::string &name, AcquisitionMode &mode);
+
+// Hands out ARGB frames from a cluon::SharedMemory area and measures how long
+// the producer is locked out for every frame.
+class FrameAcquisition
+{
+  private:
+    FrameAcquisition(const FrameAcquisition &) = delete;
+    FrameAcquisition(FrameAcquisition &&) = delete;
+    FrameAcquisition &operator=(const FrameAcquisition &) = delete;
+    FrameAcquisition &operator=(FrameAcquisition &&) = delete;
+
+  public:
+    FrameAcquisition(cluon::SharedMemory &sharedMemory, uint32_t width, uint32_t height, AcquisitionMode mode, uint32_t ringSize = 3);
+
+    // Wait for the next frame and return it. Only the region of interest is
+    // guaranteed to hold valid pixels; in Direct mode the returned matrix aliases
+    // the shared memory and must not be used after release().
+    const cv::Mat &acquire();
+
+    // Give the frame back; unlocks the shared memory if acquire() left it locked.
+    void release();
+
+    // Wake a thread blocked in acquire() so that it can notice a shutdown. Every
+    // other reader of the shared memory area is woken up as well.
+    void interrupt() noexcept;
+
+    AcquisitionMode mode() const noexcept;
+    const RegionOfInterest &regionOfInterest() const noexcept;
+    int64_t sampleTimeStamp() const noexcept;
+
+    // Time between lock() and unlock() for the most recently released frame.
+    int64_t lockHoldMicroseconds() const noexcept;
+
+  private:
+    void unlock();
+
+  private:
+    cluon::SharedMemory &m_sharedMemory;
+    const uint32_t m_width;
+    const uint32_t m_height;
+    const AcquisitionMode m_mode;
+    const RegionOfInterest m_roi;
+    std::vector<cv::Mat> m_buffers{};
+    cv::Mat m_frame{};
+    uint32_t m_next{0};
+    bool m_locked{false};
+    int64_t m_sampleTimeStamp{0};
+    std::chrono::steady_clock::time_point m_lockedAt{};
+    int64_t m_lockHoldMicroseconds{0};
+};
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "frame-decoder.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <cstring>
+
+#ifdef HAVE_OPENH264
+#include <wels/codec_api.h>
+#endif
+
+FrameDecoder::FrameDecoder() noexcept
+{
+#ifdef HAVE_OPENH264
+    if (0 == WelsCreateDecoder(&m_decoder))
+    {
+        SDecodingParam parameters;
+        std::memset(&parameters, 0, sizeof(parameters));
+        parameters.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_AVC;
+        if (0 != m_decoder->Initialize(&parameters))
+        {
+            WelsDestroyDecoder(m_decoder);
+            m_decoder = nullptr;
+        }
+    }
+    else
+    {
+        m_decoder = nullptr;
+    }
+#endif
+}
+
+FrameDecoder::~FrameDecoder()
+{
+#ifdef HAVE_OPENH264
+    if (nullptr != m_decoder)
+    {
+        m_decoder->Uninitialize();
+        WelsDestroyDecoder(m_decoder);
+    }
+#endif
+}
+
+bool FrameDecoder::supports(const std::string &fourcc) const noexcept
+{
+    return ("I420" == fourcc) || (("h264" == fourcc) && (nullptr != m_decoder));
+}
+
+bool FrameDecoder::decode(const std::string &fourcc, const std::string &data, uint32_t width, uint32_t height, cv::Mat &bgra)
+{
+    if ("I420" == fourcc)
+    {
+        const size_t size{static_cast<size_t>(width) * height * 3 / 2};
+        if (data.size() < size)
+        {
+            return false;
+        }
+        const cv::Mat i420(static_cast<int>(height * 3 / 2), static_cast<int>(width), CV_8UC1, const_cast<char *>(data.data()));
+        cv::cvtColor(i420, bgra, cv::COLOR_YUV2BGRA_I420);
+        return true;
+    }
+#ifdef HAVE_OPENH264
+    if (("h264" == fourcc) && (nullptr != m_decoder))
+    {
+        uint8_t *planes[3]{nullptr, nullptr, nullptr};
+        SBufferInfo info;
+        std::memset(&info, 0, sizeof(info));
+        const int32_t length{static_cast<int32_t>(data.size())};
+        if ((0 != m_decoder->DecodeFrameNoDelay(reinterpret_cast<const uint8_t *>(data.data()), length, planes, &info)) || (1 != info.iBufferStatus))
+        {
+            return false;
+        }
+
+        // The decoder hands out padded planes; gather them into one I420 image for the conversion.
+        const int32_t w{info.UsrData.sSystemBuffer.iWidth};
+        const int32_t h{info.UsrData.sSystemBuffer.iHeight};
+        const int32_t lumaStride{info.UsrData.sSystemBuffer.iStride[0]};
+        const int32_t chromaStride{info.UsrData.sSystemBuffer.iStride[1]};
+        m_i420.create(h * 3 / 2, w, CV_8UC1);
+        uint8_t *out{m_i420.ptr<uint8_t>(0)};
+        for (int32_t y{0}; y < h; y++, out += w)
+        {
+            std::memcpy(out, planes[0] + y * lumaStride, static_cast<size_t>(w));
+        }
+        for (int32_t plane{1}; plane < 3; plane++)
+        {
+            for (int32_t y{0}; y < h / 2; y++, out += w / 2)
+            {
+                std::memcpy(out, planes[plane] + y * chromaStride, static_cast<size_t>(w / 2));
+            }
+        }
+        cv::cvtColor(m_i420, bgra, cv::COLOR_YUV2BGRA_I420);
+        return true;
+    }
+#endif
+    return false;
+}
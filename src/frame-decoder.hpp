@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_DECODER_HPP
+#define FRAME_DECODER_HPP
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+#include <string>
+
+class ISVCDecoder;
+
+// Turns the payload of opendlv.proxy.ImageReading messages into BGRA frames, the
+// format the video decoder writes into the shared memory. h264 is decoded with
+// OpenH264 when built with HAVE_OPENH264; I420 frames are only converted.
+class FrameDecoder
+{
+  private:
+    FrameDecoder(const FrameDecoder &) = delete;
+    FrameDecoder(FrameDecoder &&) = delete;
+    FrameDecoder &operator=(const FrameDecoder &) = delete;
+    FrameDecoder &operator=(FrameDecoder &&) = delete;
+
+  public:
+    FrameDecoder() noexcept;
+    ~FrameDecoder();
+
+    // Whether frames of the given four character code can be decoded.
+    bool supports(const std::string &fourcc) const noexcept;
+
+    // Decode one frame into bgra; returns false when the data holds no complete
+    // picture (yet) or the format is not supported.
+    bool decode(const std::string &fourcc, const std::string &data, uint32_t width, uint32_t height, cv::Mat &bgra);
+
+  private:
+    ISVCDecoder *m_decoder{nullptr};
+    cv::Mat m_i420{};
+};
+
+#endif
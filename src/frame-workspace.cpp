@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "frame-workspace.hpp"
+#include "allocation-counter.hpp"
+
+#include <cassert>
+
+FrameWorkspace::FrameWorkspace(uint32_t width, uint32_t height, const RegionOfInterest &roi)
+    : maskRegion{maskRegionFor(width, height, roi)}
+    , coneMasks{static_cast<uint32_t>(maskRegion.width), static_cast<uint32_t>(maskRegion.height), 2}
+    , blobExtractor{static_cast<uint32_t>(maskRegion.width), static_cast<uint32_t>(maskRegion.height)}
+{
+    const int rows{static_cast<int>(height)};
+    const int cols{static_cast<int>(width)};
+    img = cv::Mat::zeros(rows, cols, CV_8UC4);
+    blueMask = cv::Mat::zeros(rows, cols, CV_8UC1);
+    yellowMask = cv::Mat::zeros(rows, cols, CV_8UC1);
+    const size_t blobs{BlobExtractor::maximumBlobs(static_cast<uint32_t>(maskRegion.width), static_cast<uint32_t>(maskRegion.height))};
+    blueBlobs.reserve(blobs);
+    yellowBlobs.reserve(blobs);
+}
+
+void FrameWorkspace::beginFrame() noexcept
+{
+    m_allocationsAtBegin = AllocationCounter::allocations();
+}
+
+void FrameWorkspace::endFrame() noexcept
+{
+    m_lastFrameAllocations = AllocationCounter::allocations() - m_allocationsAtBegin;
+    // The first frame may still grow containers to their working size.
+    assert((0 == m_frames) || (0 == m_lastFrameAllocations));
+    m_frames++;
+}
+
+uint64_t FrameWorkspace::frames() const noexcept
+{
+    return m_frames;
+}
+
+uint64_t FrameWorkspace::lastFrameAllocations() const noexcept
+{
+    return m_lastFrameAllocations;
+}
+
+RegionOfInterest FrameWorkspace::maskRegionFor(uint32_t width, uint32_t height, const RegionOfInterest &roi) noexcept
+{
+    const int32_t margin{static_cast<int32_t>(CLOSE_RADIUS)};
+    return clipRegionOfInterest(RegionOfInterest{roi.x - margin, roi.y - margin, roi.width + 2 * margin, roi.height + 2 * margin}, width, height);
+}
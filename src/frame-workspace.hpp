@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_WORKSPACE_HPP
+#define FRAME_WORKSPACE_HPP
+
+#include "binary-morphology.hpp"
+#include "blob-extraction.hpp"
+#include "region-of-interest.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Rectangles to remove noise (5x5 opening) and to merge individual smaller boxes within a bigger cone box (9x9 closing).
+constexpr uint32_t MERGE_RADIUS{2};
+constexpr uint32_t CLOSE_RADIUS{4};
+
+// Everything the vision loop needs per frame, allocated once and reused so that
+// the steady state does not touch the heap. In builds without NDEBUG that count
+// allocations, endFrame() asserts that no allocation happened on the calling thread
+// since beginFrame() once the first frame has sized all buffers. Segmentation,
+// morphology, blob extraction and steering run unpaused; only the --verbose display
+// and log output are excluded with AllocationCounter::Pause.
+class FrameWorkspace
+{
+  private:
+    FrameWorkspace(const FrameWorkspace &) = delete;
+    FrameWorkspace(FrameWorkspace &&) = delete;
+    FrameWorkspace &operator=(const FrameWorkspace &) = delete;
+    FrameWorkspace &operator=(FrameWorkspace &&) = delete;
+
+  public:
+    FrameWorkspace(uint32_t width, uint32_t height, const RegionOfInterest &roi);
+
+    void beginFrame() noexcept;
+    void endFrame() noexcept;
+
+    uint64_t frames() const noexcept;
+    uint64_t lastFrameAllocations() const noexcept;
+
+    // The region of interest grown by CLOSE_RADIUS and clipped to the frame.
+    static RegionOfInterest maskRegionFor(uint32_t width, uint32_t height, const RegionOfInterest &roi) noexcept;
+
+  public:
+    // Copy of the frame to draw on and display.
+    cv::Mat img{};
+    // Cone masks; the segmentation only writes the region of interest, the rest stays zero.
+    cv::Mat blueMask{};
+    cv::Mat yellowMask{};
+    // Region of interest grown by CLOSE_RADIUS, so that the dilation of the closing has room to spread.
+    RegionOfInterest maskRegion;
+    // Blue (plane 0) and yellow (plane 1) mask of maskRegion, bit-packed for the morphology.
+    PackedMasks coneMasks;
+    // Connected components of both planes, with capacity for the worst case.
+    BlobExtractor blobExtractor;
+    std::vector<Blob> blueBlobs{};
+    std::vector<Blob> yellowBlobs{};
+
+  private:
+    uint64_t m_frames{0};
+    uint64_t m_allocationsAtBegin{0};
+    uint64_t m_lastFrameAllocations{0};
+};
+
+#endif
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hsv-threshold.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HSV_THRESHOLD_HAVE_AVX2
+#endif
+
+namespace
+{
+// Fixed-point division tables from OpenCV's RGB2HSV_b so that the results match cv::cvtColor.
+constexpr int32_t HSV_SHIFT{12};
+constexpr int32_t HSV_ROUND{1 << (HSV_SHIFT - 1)};
+
+struct HsvDivisionTables
+{
+    std::array<int32_t, 256> s;
+    std::array<int32_t, 256> h;
+};
+
+const HsvDivisionTables &divisionTables() noexcept
+{
+    static const HsvDivisionTables TABLES = []() {
+        HsvDivisionTables t{};
+        for (int32_t i{1}; i < 256; i++)
+        {
+            t.s[static_cast<size_t>(i)] = static_cast<int32_t>(std::lround((255 << HSV_SHIFT) / (1.0 * i)));
+            t.h[static_cast<size_t>(i)] = static_cast<int32_t>(std::lround((180 << HSV_SHIFT) / (6.0 * i)));
+        }
+        return t;
+    }();
+    return TABLES;
+}
+
+inline void hsv(const HsvDivisionTables &tables, int32_t b, int32_t g, int32_t r, int32_t &h, int32_t &s, int32_t &v) noexcept
+{
+    v = std::max(std::max(b, g), r);
+    const int32_t vmin{std::min(std::min(b, g), r)};
+    const int32_t diff{v - vmin};
+
+    s = (diff * tables.s[static_cast<size_t>(v)] + HSV_ROUND) >> HSV_SHIFT;
+    if (v == r)
+    {
+        h = g - b;
+    }
+    else if (v == g)
+    {
+        h = b - r + 2 * diff;
+    }
+    else
+    {
+        h = r - g + 4 * diff;
+    }
+    h = (h * tables.h[static_cast<size_t>(diff)] + HSV_ROUND) >> HSV_SHIFT;
+    h += (h < 0) ? 180 : 0;
+}
+
+void thresholdRowScalar(const HsvDivisionTables &tables, const uint8_t *bgra, uint32_t begin, uint32_t end, const ConeColourThresholds &thresholds,
+                        uint8_t *blueMask, uint8_t *yellowMask) noexcept
+{
+    for (uint32_t x{begin}; x < end; x++)
+    {
+        const uint8_t *p{bgra + 4 * x};
+        int32_t hue, saturation, value;
+        hsv(tables, p[0], p[1], p[2], hue, saturation, value);
+        const uint8_t h{static_cast<uint8_t>(hue)};
+        const uint8_t s{static_cast<uint8_t>(saturation)};
+        const uint8_t v{static_cast<uint8_t>(value)};
+        blueMask[x] = isInside(thresholds.blue, h, s, v) ? 255 : 0;
+        yellowMask[x] = isInside(thresholds.yellow, h, s, v) ? 255 : 0;
+    }
+}
+
+#ifdef HSV_THRESHOLD_HAVE_AVX2
+// All-ones in every 32-bit lane whose value lies outside of [lower, upper].
+__attribute__((target("avx2"))) inline __m256i outside(__m256i value, int32_t lower, int32_t upper) noexcept
+{
+    return _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(lower), value), _mm256_cmpgt_epi32(value, _mm256_set1_epi32(upper)));
+}
+
+__attribute__((target("avx2"))) inline void store8(uint8_t *destination, __m256i lanes) noexcept
+{
+    // Narrow eight 0/-1 lanes to eight 0/255 bytes.
+    const __m256i words{_mm256_packs_epi32(lanes, lanes)};
+    const __m256i bytes{_mm256_packs_epi16(words, words)};
+    const int32_t low{_mm_cvtsi128_si32(_mm256_castsi256_si128(bytes))};
+    const int32_t high{_mm_cvtsi128_si32(_mm256_extracti128_si256(bytes, 1))};
+    std::memcpy(destination, &low, sizeof(low));
+    std::memcpy(destination + 4, &high, sizeof(high));
+}
+
+// Eight pixels per step, one pixel per 32-bit lane; same arithmetic as hsv() above.
+__attribute__((target("avx2"))) uint32_t thresholdRowAVX2(const HsvDivisionTables &tables, const uint8_t *bgra, uint32_t width,
+                                                          const ConeColourThresholds &thresholds, uint8_t *blueMask, uint8_t *yellowMask) noexcept
+{
+    const __m256i byteMask{_mm256_set1_epi32(0xff)};
+    const __m256i round{_mm256_set1_epi32(HSV_ROUND)};
+    const __m256i hueRange{_mm256_set1_epi32(180)};
+    const __m256i ones{_mm256_set1_epi32(-1)};
+    const HsvRange &blue{thresholds.blue};
+    const HsvRange &yellow{thresholds.yellow};
+
+    uint32_t x{0};
+    for (; x + 8 <= width; x += 8)
+    {
+        const __m256i pixels{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(bgra + 4 * x))};
+        const __m256i b{_mm256_and_si256(pixels, byteMask)};
+        const __m256i g{_mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask)};
+        const __m256i r{_mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask)};
+
+        const __m256i v{_mm256_max_epi32(_mm256_max_epi32(b, g), r)};
+        const __m256i vmin{_mm256_min_epi32(_mm256_min_epi32(b, g), r)};
+        const __m256i diff{_mm256_sub_epi32(v, vmin)};
+
+        const __m256i sdiv{_mm256_i32gather_epi32(tables.s.data(), v, 4)};
+        const __m256i s{_mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(diff, sdiv), round), HSV_SHIFT)};
+
+        const __m256i hr{_mm256_sub_epi32(g, b)};
+        const __m256i hg{_mm256_add_epi32(_mm256_sub_epi32(b, r), _mm256_slli_epi32(diff, 1))};
+        const __m256i hb{_mm256_add_epi32(_mm256_sub_epi32(r, g), _mm256_slli_epi32(diff, 2))};
+        const __m256i isR{_mm256_cmpeq_epi32(v, r)};
+        const __m256i isG{_mm256_cmpeq_epi32(v, g)};
+        __m256i h{_mm256_blendv_epi8(_mm256_blendv_epi8(hb, hg, isG), hr, isR)};
+        const __m256i hdiv{_mm256_i32gather_epi32(tables.h.data(), diff, 4)};
+        h = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(h, hdiv), round), HSV_SHIFT);
+        h = _mm256_add_epi32(h, _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), h), hueRange));
+
+        const __m256i outsideBlue{_mm256_or_si256(_mm256_or_si256(outside(h, blue.lowerH, blue.upperH), outside(s, blue.lowerS, blue.upperS)),
+                                                  outside(v, blue.lowerV, blue.upperV))};
+        const __m256i outsideYellow{_mm256_or_si256(_mm256_or_si256(outside(h, yellow.lowerH, yellow.upperH), outside(s, yellow.lowerS, yellow.upperS)),
+                                                    outside(v, yellow.lowerV, yellow.upperV))};
+        store8(blueMask + x, _mm256_xor_si256(outsideBlue, ones));
+        store8(yellowMask + x, _mm256_xor_si256(outsideYellow, ones));
+    }
+    return x;
+}
+
+bool cpuHasAVX2() noexcept
+{
+    static const bool HAS_AVX2{0 != __builtin_cpu_supports("avx2")};
+    return HAS_AVX2;
+}
+#endif
+} // namespace
+
+bool operator==(const HsvRange &a, const HsvRange &b) noexcept
+{
+    return (a.lowerH == b.lowerH) && (a.lowerS == b.lowerS) && (a.lowerV == b.lowerV) && (a.upperH == b.upperH) && (a.upperS == b.upperS) && (a.upperV == b.upperV);
+}
+
+bool operator==(const ConeColourThresholds &a, const ConeColourThresholds &b) noexcept
+{
+    return (a.blue == b.blue) && (a.yellow == b.yellow);
+}
+
+bool operator!=(const ConeColourThresholds &a, const ConeColourThresholds &b) noexcept
+{
+    return !(a == b);
+}
+
+void bgraToHsv(const uint8_t *bgra, uint8_t &h, uint8_t &s, uint8_t &v) noexcept
+{
+    int32_t hue, saturation, value;
+    hsv(divisionTables(), bgra[0], bgra[1], bgra[2], hue, saturation, value);
+    h = static_cast<uint8_t>(hue);
+    s = static_cast<uint8_t>(saturation);
+    v = static_cast<uint8_t>(value);
+}
+
+void thresholdCones(const uint8_t *bgra, size_t bgraStride, uint32_t width, uint32_t height, const ConeColourThresholds &thresholds,
+                    uint8_t *blueMask, uint8_t *yellowMask, size_t maskStride) noexcept
+{
+    const HsvDivisionTables &tables{divisionTables()};
+    for (uint32_t y{0}; y < height; y++)
+    {
+        const uint8_t *row{bgra + y * bgraStride};
+        uint8_t *blueRow{blueMask + y * maskStride};
+        uint8_t *yellowRow{yellowMask + y * maskStride};
+
+        uint32_t x{0};
+#ifdef HSV_THRESHOLD_HAVE_AVX2
+        if (cpuHasAVX2())
+        {
+            x = thresholdRowAVX2(tables, row, width, thresholds, blueRow, yellowRow);
+        }
+#endif
+        thresholdRowScalar(tables, row, x, width, thresholds, blueRow, yellowRow);
+    }
+}
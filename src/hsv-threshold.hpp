@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HSV_THRESHOLD_HPP
+#define HSV_THRESHOLD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Inclusive HSV bounds as used by cv::inRange (H in [0, 180), S and V in [0, 255]).
+struct HsvRange
+{
+    uint8_t lowerH;
+    uint8_t lowerS;
+    uint8_t lowerV;
+    uint8_t upperH;
+    uint8_t upperS;
+    uint8_t upperV;
+};
+
+// Colour ranges for both cone colours, derived through experimentation with colour-space images.
+struct ConeColourThresholds
+{
+    HsvRange blue{78, 50, 50, 134, 255, 255};
+    HsvRange yellow{9, 0, 147, 76, 255, 255};
+};
+
+bool operator==(const HsvRange &a, const HsvRange &b) noexcept;
+bool operator==(const ConeColourThresholds &a, const ConeColourThresholds &b) noexcept;
+bool operator!=(const ConeColourThresholds &a, const ConeColourThresholds &b) noexcept;
+
+// True if the HSV value lies inside the inclusive range.
+inline bool isInside(const HsvRange &range, uint8_t h, uint8_t s, uint8_t v) noexcept
+{
+    return (range.lowerH <= h) && (h <= range.upperH) && (range.lowerS <= s) && (s <= range.upperS) && (range.lowerV <= v) && (v <= range.upperV);
+}
+
+// Convert an 8-bit BGRA pixel to HSV bit-exactly like cv::cvtColor(..., cv::COLOR_BGR2HSV).
+void bgraToHsv(const uint8_t *bgra, uint8_t &h, uint8_t &s, uint8_t &v) noexcept;
+
+// Fused replacement for cv::cvtColor(COLOR_BGR2HSV) followed by two cv::inRange calls:
+// visits every BGRA pixel of a width x height region once and writes 255 into
+// blueMask and yellowMask where the pixel lies inside the respective range, 0 elsewhere.
+// Uses AVX2 when the CPU supports it.
+void thresholdCones(const uint8_t *bgra, size_t bgraStride, uint32_t width, uint32_t height, const ConeColourThresholds &thresholds,
+                    uint8_t *blueMask, uint8_t *yellowMask, size_t maskStride) noexcept;
+
+#endif
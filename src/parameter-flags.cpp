@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "parameter-flags.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+bool parseNumber(const std::string &text, double &value)
+{
+    size_t parsed{0};
+    try
+    {
+        value = std::stod(text, &parsed);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    return (parsed == text.size()) && std::isfinite(value);
+}
+
+bool parseBound(const std::string &text, uint8_t &bound)
+{
+    size_t parsed{0};
+    int32_t value{0};
+    try
+    {
+        value = std::stoi(text, &parsed);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    if ((parsed != text.size()) || (value < 0) || (value > 255))
+    {
+        return false;
+    }
+    bound = static_cast<uint8_t>(value);
+    return true;
+}
+
+// The shortest decimal form that parses back to the same double.
+std::string shortest(double value)
+{
+    std::string text;
+    for (int32_t precision{6}; precision <= std::numeric_limits<double>::max_digits10; precision++)
+    {
+        std::ostringstream out;
+        out << std::setprecision(precision) << value;
+        text = out.str();
+        const double parsed{std::stod(text)};
+        if (!std::isless(parsed, value) && !std::isgreater(parsed, value))
+        {
+            break;
+        }
+    }
+    return text;
+}
+} // namespace
+
+bool parseSteeringParameters(const std::map<std::string, std::string> &arguments, SteeringParameters &parameters, std::string &invalidFlag)
+{
+    for (const auto &flag : STEERING_PARAMETER_FLAGS)
+    {
+        const auto argument{arguments.find(flag.name)};
+        if (arguments.end() == argument)
+        {
+            continue;
+        }
+        double value{0.0};
+        if (!parseNumber(argument->second, value))
+        {
+            invalidFlag = flag.name;
+            return false;
+        }
+        parameters.*flag.member = value;
+    }
+    return true;
+}
+
+bool parseConeColourThresholds(const std::map<std::string, std::string> &arguments, ConeColourThresholds &thresholds, std::string &invalidFlag)
+{
+    for (const auto &flag : THRESHOLD_FLAGS)
+    {
+        const auto argument{arguments.find(flag.name)};
+        if (arguments.end() == argument)
+        {
+            continue;
+        }
+        if (!parseBound(argument->second, thresholds.*flag.colour.*flag.bound))
+        {
+            invalidFlag = flag.name;
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string describeParameters(const ConeColourThresholds &thresholds, const SteeringParameters &parameters)
+{
+    std::ostringstream out;
+    for (const auto &flag : STEERING_PARAMETER_FLAGS)
+    {
+        out << " --" << flag.name << "=" << shortest(parameters.*flag.member);
+    }
+    for (const auto &flag : THRESHOLD_FLAGS)
+    {
+        out << " --" << flag.name << "=" << static_cast<uint32_t>(thresholds.*flag.colour.*flag.bound);
+    }
+    return out.str();
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARAMETER_FLAGS_HPP
+#define PARAMETER_FLAGS_HPP
+
+#include "hsv-threshold.hpp"
+#include "steering-algorithm.hpp"
+
+#include <map>
+#include <string>
+
+// Steering parameters that can be given on the command line, by their flag name.
+struct SteeringParameterFlag
+{
+    const char *name;
+    double SteeringParameters::*member;
+};
+
+constexpr SteeringParameterFlag STEERING_PARAMETER_FLAGS[]{{"positive-gain", &SteeringParameters::positiveGain},
+                                                           {"positive-derivative-gain", &SteeringParameters::positiveDerivativeGain},
+                                                           {"positive-offset", &SteeringParameters::positiveOffset},
+                                                           {"negative-gain", &SteeringParameters::negativeGain},
+                                                           {"negative-derivative-gain", &SteeringParameters::negativeDerivativeGain},
+                                                           {"negative-offset", &SteeringParameters::negativeOffset}};
+
+// HSV bounds that can be given on the command line, by their flag name.
+struct ThresholdFlag
+{
+    const char *name;
+    HsvRange ConeColourThresholds::*colour;
+    uint8_t HsvRange::*bound;
+};
+
+constexpr ThresholdFlag THRESHOLD_FLAGS[]{{"blue-lower-h", &ConeColourThresholds::blue, &HsvRange::lowerH},
+                                          {"blue-lower-s", &ConeColourThresholds::blue, &HsvRange::lowerS},
+                                          {"blue-lower-v", &ConeColourThresholds::blue, &HsvRange::lowerV},
+                                          {"blue-upper-h", &ConeColourThresholds::blue, &HsvRange::upperH},
+                                          {"blue-upper-s", &ConeColourThresholds::blue, &HsvRange::upperS},
+                                          {"blue-upper-v", &ConeColourThresholds::blue, &HsvRange::upperV},
+                                          {"yellow-lower-h", &ConeColourThresholds::yellow, &HsvRange::lowerH},
+                                          {"yellow-lower-s", &ConeColourThresholds::yellow, &HsvRange::lowerS},
+                                          {"yellow-lower-v", &ConeColourThresholds::yellow, &HsvRange::lowerV},
+                                          {"yellow-upper-h", &ConeColourThresholds::yellow, &HsvRange::upperH},
+                                          {"yellow-upper-s", &ConeColourThresholds::yellow, &HsvRange::upperS},
+                                          {"yellow-upper-v", &ConeColourThresholds::yellow, &HsvRange::upperV}};
+
+// Override parameters with the flags among the command line arguments; returns false
+// and the name of the first flag that is not a number, or not one in [0, 255] for the
+// HSV bounds. Flags that are not given keep their value.
+bool parseSteeringParameters(const std::map<std::string, std::string> &arguments, SteeringParameters &parameters, std::string &invalidFlag);
+bool parseConeColourThresholds(const std::map<std::string, std::string> &arguments, ConeColourThresholds &thresholds, std::string &invalidFlag);
+
+// Command line flags reproducing a parameter set; the values read back exactly.
+std::string describeParameters(const ConeColourThresholds &thresholds, const SteeringParameters &parameters);
+
+#endif
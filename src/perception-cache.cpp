@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "perception-cache.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+
+namespace
+{
+constexpr char MAGIC[8]{'P', 'E', 'R', 'C', 'A', 'C', 'H', 'E'};
+// Version 2: cone flags decided on the blobs in findContours order.
+// Version 3: cone flags only, keyed on the recording's size and modification time.
+// Version 4: blobs and cone flags again.
+constexpr uint32_t VERSION{4};
+
+constexpr uint64_t FNV_OFFSET_BASIS{14695981039346656037ull};
+constexpr uint64_t FNV_PRIME{1099511628211ull};
+
+// Frames and blobs follow the header directly; all parts keep 8-byte alignment.
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t blobSize;
+    uint64_t recording;
+    uint64_t segmentation;
+    uint64_t frames;
+    uint64_t blobs;
+};
+
+static_assert(std::is_trivially_copyable<CachedFrame>::value, "frames are stored as they are in memory");
+static_assert(std::is_trivially_copyable<Blob>::value, "blobs are stored as they are in memory");
+static_assert(0 == sizeof(Header) % 8, "frames must stay aligned");
+static_assert(0 == sizeof(CachedFrame) % 8, "blobs must stay aligned");
+
+uint64_t fnv1a(uint64_t hash, const uint8_t *bytes, size_t size) noexcept
+{
+    for (size_t i{0}; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+// A read-only private mapping of a whole file; nullptr if it cannot be mapped.
+void *mapFile(const std::string &path, size_t &size) noexcept
+{
+    size = 0;
+    const int fd{::open(path.c_str(), O_RDONLY)};
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    struct stat info;
+    void *data{nullptr};
+    if ((0 == ::fstat(fd, &info)) && (0 < info.st_size))
+    {
+        size = static_cast<size_t>(info.st_size);
+        data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED == data)
+        {
+            data = nullptr;
+            size = 0;
+        }
+    }
+    ::close(fd);
+    return data;
+}
+} // namespace
+
+uint64_t hashRecording(const std::string &path) noexcept
+{
+    struct stat info;
+    if (0 != ::stat(path.c_str(), &info))
+    {
+        return 0;
+    }
+    // Rewriting a recording in place changes its modification time, copying it with cp -p does not.
+    const int64_t values[]{static_cast<int64_t>(info.st_size), static_cast<int64_t>(info.st_mtim.tv_sec), static_cast<int64_t>(info.st_mtim.tv_nsec)};
+    const uint64_t hash{fnv1a(FNV_OFFSET_BASIS, reinterpret_cast<const uint8_t *>(values), sizeof(values))};
+    // 0 is reserved for recordings that cannot be cached.
+    return (0 == hash) ? 1 : hash;
+}
+
+uint64_t hashSegmentation(const ConeColourThresholds &thresholds, uint32_t lutBits, uint32_t width, uint32_t height, const RegionOfInterest &roi) noexcept
+{
+    const uint8_t bytes[]{thresholds.blue.lowerH,   thresholds.blue.lowerS,   thresholds.blue.lowerV,   thresholds.blue.upperH,
+                          thresholds.blue.upperS,   thresholds.blue.upperV,   thresholds.yellow.lowerH, thresholds.yellow.lowerS,
+                          thresholds.yellow.lowerV, thresholds.yellow.upperH, thresholds.yellow.upperS, thresholds.yellow.upperV,
+                          static_cast<uint8_t>(lutBits)};
+    // The same recording segmented at another size or with another region of interest finds other cones.
+    const int64_t geometry[]{width, height, roi.x, roi.y, roi.width, roi.height};
+    return fnv1a(fnv1a(FNV_OFFSET_BASIS, bytes, sizeof(bytes)), reinterpret_cast<const uint8_t *>(geometry), sizeof(geometry));
+}
+
+std::string perceptionCachePath(const std::string &directory, const PerceptionCacheKey &key)
+{
+    std::ostringstream name;
+    name << directory << "/" << std::hex << std::setfill('0') << std::setw(16) << key.recording << "-" << std::setw(16) << key.segmentation << ".perception";
+    return name.str();
+}
+
+void PerceptionCacheWriter::add(int64_t sampleTimeStamp, const std::vector<Blob> &blueBlobs, const std::vector<Blob> &yellowBlobs, const ConeSides &cones)
+{
+    m_frames.push_back(CachedFrame{sampleTimeStamp, static_cast<uint32_t>(m_blobs.size()), static_cast<uint32_t>(blueBlobs.size()),
+                                   static_cast<uint32_t>(yellowBlobs.size()), static_cast<uint8_t>(cones.leftCone ? 1 : 0),
+                                   static_cast<uint8_t>(cones.rightCone ? 1 : 0), {0, 0}});
+    m_blobs.insert(m_blobs.end(), blueBlobs.begin(), blueBlobs.end());
+    m_blobs.insert(m_blobs.end(), yellowBlobs.begin(), yellowBlobs.end());
+}
+
+bool PerceptionCacheWriter::write(const std::string &path, const PerceptionCacheKey &key) const
+{
+    // Recordings are replayed in sending order, which may differ from the sample time stamps.
+    std::vector<CachedFrame> frames{m_frames};
+    std::stable_sort(frames.begin(), frames.end(), [](const CachedFrame &a, const CachedFrame &b) { return a.sampleTimeStamp < b.sampleTimeStamp; });
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.blobSize = sizeof(Blob);
+    header.recording = key.recording;
+    header.segmentation = key.segmentation;
+    header.frames = frames.size();
+    header.blobs = m_blobs.size();
+
+    const std::string temporary{path + ".tmp"};
+    {
+        std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(frames.data()), static_cast<std::streamsize>(frames.size() * sizeof(CachedFrame)));
+        out.write(reinterpret_cast<const char *>(m_blobs.data()), static_cast<std::streamsize>(m_blobs.size() * sizeof(Blob)));
+        if (!out.good())
+        {
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    return 0 == std::rename(temporary.c_str(), path.c_str());
+}
+
+PerceptionCache::PerceptionCache(const std::string &path, const PerceptionCacheKey &key) noexcept
+{
+    m_data = mapFile(path, m_size);
+    if (nullptr == m_data)
+    {
+        return;
+    }
+    const uint8_t *bytes{static_cast<const uint8_t *>(m_data)};
+    const Header *header{reinterpret_cast<const Header *>(bytes)};
+    const bool matches{(sizeof(Header) <= m_size) && (0 == std::memcmp(header->magic, MAGIC, sizeof(MAGIC))) && (VERSION == header->version) &&
+                       (sizeof(Blob) == header->blobSize) && (key.recording == header->recording) && (key.segmentation == header->segmentation) &&
+                       (m_size == sizeof(Header) + header->frames * sizeof(CachedFrame) + header->blobs * sizeof(Blob))};
+    if (!matches)
+    {
+        ::munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+        return;
+    }
+    m_frames = reinterpret_cast<const CachedFrame *>(bytes + sizeof(Header));
+    m_frameCount = static_cast<size_t>(header->frames);
+    m_blobs = reinterpret_cast<const Blob *>(bytes + sizeof(Header) + m_frameCount * sizeof(CachedFrame));
+    m_blobCount = static_cast<size_t>(header->blobs);
+}
+
+PerceptionCache::~PerceptionCache()
+{
+    if (nullptr != m_data)
+    {
+        ::munmap(m_data, m_size);
+    }
+}
+
+bool PerceptionCache::valid() const noexcept
+{
+    return nullptr != m_data;
+}
+
+CachedPerception PerceptionCache::find(int64_t sampleTimeStamp) const noexcept
+{
+    const CachedFrame *end{m_frames + m_frameCount};
+    const CachedFrame *frame{std::lower_bound(m_frames, end, sampleTimeStamp,
+                                              [](const CachedFrame &f, int64_t timeStamp) { return f.sampleTimeStamp < timeStamp; })};
+    // A frame whose blobs lie outside of the blob array is treated as missing.
+    if ((end == frame) || (sampleTimeStamp != frame->sampleTimeStamp) ||
+        (m_blobCount < static_cast<size_t>(frame->firstBlob) + frame->blueBlobs + frame->yellowBlobs))
+    {
+        return CachedPerception{nullptr, nullptr, nullptr};
+    }
+    const Blob *blue{m_blobs + frame->firstBlob};
+    return CachedPerception{frame, blue, blue + frame->blueBlobs};
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERCEPTION_CACHE_HPP
+#define PERCEPTION_CACHE_HPP
+
+#include "blob-extraction.hpp"
+#include "cone-detection.hpp"
+#include "hsv-threshold.hpp"
+#include "region-of-interest.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What the perception of one frame found: its blobs are blueBlobs blue ones followed
+// by yellowBlobs yellow ones, starting at firstBlob in the blob array of the cache.
+struct CachedFrame
+{
+    int64_t sampleTimeStamp;
+    uint32_t firstBlob;
+    uint32_t blueBlobs;
+    uint32_t yellowBlobs;
+    uint8_t leftCone;
+    uint8_t rightCone;
+    uint8_t padding[2];
+};
+
+// A cached frame and its blobs inside the mapped cache; frame is nullptr if there is none.
+struct CachedPerception
+{
+    const CachedFrame *frame;
+    const Blob *blueBlobs;
+    const Blob *yellowBlobs;
+};
+
+// Identifies the perception results of one recording: a hash of the recording file's
+// size and modification time, and of how its frames were segmented (thresholds,
+// lookup table bits with 0 for HSV, frame size and the clipped region of interest).
+struct PerceptionCacheKey
+{
+    uint64_t recording;
+    uint64_t segmentation;
+};
+
+// 64-bit FNV-1a of the file's size and modification time, so that recordings of
+// several GB are not read just to look up their cache; 0 if it cannot be stat'ed,
+// in which case the recording must not be cached.
+uint64_t hashRecording(const std::string &path) noexcept;
+uint64_t hashSegmentation(const ConeColourThresholds &thresholds, uint32_t lutBits, uint32_t width, uint32_t height, const RegionOfInterest &roi) noexcept;
+
+// File name of the cache for key inside directory.
+std::string perceptionCachePath(const std::string &directory, const PerceptionCacheKey &key);
+
+// Collects the perception results of a recording's frames in replay order and writes
+// them into a cache file.
+class PerceptionCacheWriter
+{
+  public:
+    void add(int64_t sampleTimeStamp, const std::vector<Blob> &blueBlobs, const std::vector<Blob> &yellowBlobs, const ConeSides &cones);
+
+    // Write all frames, sorted by sample time stamp, through a temporary file that is
+    // renamed into place, so that readers never see a partial cache.
+    bool write(const std::string &path, const PerceptionCacheKey &key) const;
+
+  private:
+    std::vector<CachedFrame> m_frames{};
+    std::vector<Blob> m_blobs{};
+};
+
+// Read-only view of a cache file mapped into memory; nothing is copied, frames are
+// found by binary search over their sample time stamps.
+class PerceptionCache
+{
+  private:
+    PerceptionCache(const PerceptionCache &) = delete;
+    PerceptionCache(PerceptionCache &&) = delete;
+    PerceptionCache &operator=(const PerceptionCache &) = delete;
+    PerceptionCache &operator=(PerceptionCache &&) = delete;
+
+  public:
+    // Map the cache at path if it exists, is well-formed and was written for key.
+    PerceptionCache(const std::string &path, const PerceptionCacheKey &key) noexcept;
+    ~PerceptionCache();
+
+    bool valid() const noexcept;
+    // The frame with the given sample time stamp and its blobs.
+    CachedPerception find(int64_t sampleTimeStamp) const noexcept;
+
+  private:
+    void *m_data{nullptr};
+    size_t m_size{0};
+    const CachedFrame *m_frames{nullptr};
+    size_t m_frameCount{0};
+    const Blob *m_blobs{nullptr};
+    size_t m_blobCount{0};
+};
+
+#endif
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "recording-evaluation.hpp"
+#include "cone-perception.hpp"
+#include "frame-workspace.hpp"
+#include "perception-cache.hpp"
+#include "recording-replay.hpp"
+#include "opendlv-standard-message-set.hpp"
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+bool withinTolerance(double steering, double groundSteering, double tolerance) noexcept
+{
+    // The bounds are taken on the magnitude, so negative requests are scored like positive ones.
+    return std::fabs(steering - groundSteering) <= tolerance * std::fabs(groundSteering);
+}
+
+std::vector<std::string> listRecordings(const std::string &directory)
+{
+    std::vector<std::string> recordings;
+    DIR *dir{opendir(directory.c_str())};
+    if (nullptr == dir)
+    {
+        return recordings;
+    }
+    while (const dirent *entry = readdir(dir))
+    {
+        const std::string name{entry->d_name};
+        if ((4 < name.size()) && (0 == name.compare(name.size() - 4, 4, ".rec")))
+        {
+            recordings.push_back(directory + "/" + name);
+        }
+    }
+    closedir(dir);
+    std::sort(recordings.begin(), recordings.end());
+    return recordings;
+}
+
+bool collectSteeringSamples(const std::string &recording, const EvaluationSettings &settings, const std::vector<ConeColourThresholds> &thresholds,
+                            std::vector<SteeringSamples> &samples, double &seconds)
+{
+    samples.assign(thresholds.size(), SteeringSamples{});
+    RecordingReplay replay{recording};
+    if (!replay.valid())
+    {
+        return false;
+    }
+
+    double groundSteering{0.0};
+    replay.dataTrigger(opendlv::proxy::GroundSteeringRequest::ID(), [&groundSteering](cluon::data::Envelope &&env) {
+        groundSteering = static_cast<double>(cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(std::move(env)).groundSteering());
+    });
+
+    YawRateEstimator yawRateEstimator{settings.yawRateFilter};
+    YawRateState yawRate{0.0, 0.0, 0};
+    replay.dataTrigger(opendlv::proxy::AngularVelocityReading::ID(), [&yawRateEstimator, &yawRate](cluon::data::Envelope &&env) {
+        if (0 == env.senderStamp())
+        {
+            const int64_t sampleTimeStamp{cluon::time::toMicroseconds(env.sampleTimeStamp())};
+            const auto reading = cluon::extractMessage<opendlv::proxy::AngularVelocityReading>(std::move(env));
+            yawRate = yawRateEstimator.update(reading.angularVelocityZ(), sampleTimeStamp);
+        }
+    });
+
+    // Samples of frame for every thresholds entry once the perception is done.
+    auto addSamples = [&](size_t i, const ConeSides &cones) {
+        SteeringSamples &s{samples[i]};
+        s.leftCone.push_back(cones.leftCone ? 1 : 0);
+        s.rightCone.push_back(cones.rightCone ? 1 : 0);
+        s.angularVeloZ.push_back(yawRate.value);
+        s.angularVeloZDerivative.push_back(yawRate.derivative);
+        s.groundSteering.push_back(groundSteering);
+    };
+
+    // A classifier only stands in for the thresholds it was built from.
+    auto classifierFor = [&settings](const ConeColourThresholds &t) -> const ConeColourClassifier * {
+        for (const ConeColourClassifier *classifier : settings.classifiers)
+        {
+            if (t == classifier->thresholds())
+            {
+                return classifier;
+            }
+        }
+        return nullptr;
+    };
+
+    const RegionOfInterest roi{clipRegionOfInterest(CONE_REGION_OF_INTEREST, settings.width, settings.height)};
+    std::vector<PerceptionCacheKey> keys;
+    std::vector<std::unique_ptr<PerceptionCache>> caches;
+    bool cached{false};
+    // Recordings that cannot be stat'ed have no key of their own and are processed without a cache.
+    const uint64_t recordingHash{settings.cacheDirectory.empty() ? 0 : hashRecording(recording)};
+    if (0 != recordingHash)
+    {
+        cached = true;
+        for (const auto &t : thresholds)
+        {
+            const ConeColourClassifier *classifier{classifierFor(t)};
+            const uint32_t lutBits{(nullptr != classifier) ? classifier->bitsPerChannel() : 0};
+            keys.push_back(PerceptionCacheKey{recordingHash, hashSegmentation(t, lutBits, settings.width, settings.height, roi)});
+            caches.emplace_back(new PerceptionCache{perceptionCachePath(settings.cacheDirectory, keys.back()), keys.back()});
+            cached = cached && caches.back()->valid();
+        }
+    }
+    if (cached)
+    {
+        // Steering only: the frames are looked up by their sample time stamps instead of being decoded.
+        replay.dataTrigger(opendlv::proxy::ImageReading::ID(), [&](cluon::data::Envelope &&env) {
+            const int64_t sampleTimeStamp{cluon::time::toMicroseconds(env.sampleTimeStamp())};
+            for (size_t i{0}; i < thresholds.size(); i++)
+            {
+                const CachedPerception perception{caches[i]->find(sampleTimeStamp)};
+                if (nullptr != perception.frame)
+                {
+                    addSamples(i, ConeSides{0 != perception.frame->leftCone, 0 != perception.frame->rightCone});
+                }
+            }
+        });
+        seconds += replay.run().seconds;
+        return true;
+    }
+
+    std::vector<PerceptionCacheWriter> writers(keys.size());
+    FrameWorkspace ws{settings.width, settings.height, roi};
+    uint64_t processedFrames{0};
+    replay.frameTrigger([&](const cv::Mat &frame, int64_t sampleTimeStamp) {
+        if ((static_cast<uint32_t>(frame.cols) != settings.width) || (static_cast<uint32_t>(frame.rows) != settings.height))
+        {
+            return;
+        }
+        processedFrames++;
+        for (size_t i{0}; i < thresholds.size(); i++)
+        {
+            segmentCones(frame, roi, thresholds[i], classifierFor(thresholds[i]), ws);
+            findConeBlobs(ws);
+            const ConeSides cones{detectConeSides(ws.blueBlobs, ws.yellowBlobs)};
+            addSamples(i, cones);
+            if (!writers.empty())
+            {
+                writers[i].add(sampleTimeStamp, ws.blueBlobs, ws.yellowBlobs, cones);
+            }
+        }
+    });
+
+    const ReplayStatistics statistics{replay.run()};
+    seconds += statistics.seconds;
+    // A recording without a single usable frame would score 0 comparisons and pass unnoticed.
+    if (0 == statistics.frames)
+    {
+        std::cerr << recording << ": No frame could be decoded." << std::endl;
+        return false;
+    }
+    if (0 == processedFrames)
+    {
+        std::cerr << recording << ": No frame is " << settings.width << "x" << settings.height << "." << std::endl;
+        return false;
+    }
+    for (size_t i{0}; i < writers.size(); i++)
+    {
+        if (!caches[i]->valid() && !writers[i].write(perceptionCachePath(settings.cacheDirectory, keys[i]), keys[i]))
+        {
+            std::cerr << recording << ": Cannot write the perception cache to " << settings.cacheDirectory << "." << std::endl;
+        }
+    }
+    return true;
+}
+
+void scoreSteering(const SteeringSamples &samples, const SteeringParameters &parameters, double tolerance, std::vector<double> &steering,
+                   RecordingScore &score)
+{
+    steering.resize(samples.size());
+    checkSteering(samples.batch(), steering.data(), parameters);
+    score.frames += samples.size();
+    for (size_t i{0}; i < samples.size(); i++)
+    {
+        // Frames without a steering request are not scored, as in the original comparison.
+        const double groundSteering{samples.groundSteering[i]};
+        if (0.0 < std::fabs(groundSteering))
+        {
+            score.comparisons++;
+            score.matches += withinTolerance(steering[i], groundSteering, tolerance) ? 1 : 0;
+        }
+    }
+}
+
+RecordingScore evaluateRecording(const std::string &recording, const EvaluationSettings &settings)
+{
+    RecordingScore score{false, 0, 0, 0, 0.0};
+    std::vector<SteeringSamples> samples;
+    if (collectSteeringSamples(recording, settings, {settings.thresholds}, samples, score.seconds))
+    {
+        score.valid = true;
+        std::vector<double> steering;
+        scoreSteering(samples.front(), settings.steering, settings.tolerance, steering, score);
+    }
+    return score;
+}
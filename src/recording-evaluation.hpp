@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RECORDING_EVALUATION_HPP
+#define RECORDING_EVALUATION_HPP
+
+#include "cone-classifier.hpp"
+#include "hsv-threshold.hpp"
+#include "steering-algorithm.hpp"
+#include "yaw-rate-estimator.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// How recordings are replayed and scored.
+struct EvaluationSettings
+{
+    uint32_t width{640};
+    uint32_t height{480};
+    ConeColourThresholds thresholds{};
+    // Lookup tables used for segmentation instead of the HSV kernel, if any; each only
+    // for frames segmented with the thresholds it was built from.
+    std::vector<const ConeColourClassifier *> classifiers{};
+    SteeringParameters steering{DEFAULT_STEERING_PARAMETERS};
+    YawRateFilterSettings yawRateFilter{};
+    // A steering angle is correct within this fraction of the recorded ground steering.
+    double tolerance{0.25};
+    // Directory of perception caches; if set, frames whose cones are cached there are
+    // not decoded or segmented again, and new results are cached.
+    std::string cacheDirectory{};
+};
+
+// Outcome of replaying one recording.
+struct RecordingScore
+{
+    bool valid;
+    uint64_t frames;
+    // Frames with a non-zero ground steering request and how many of them were steered correctly.
+    uint64_t comparisons;
+    uint64_t matches;
+    double seconds;
+
+    double accuracy() const noexcept
+    {
+        return (0 < comparisons) ? static_cast<double>(matches) / static_cast<double>(comparisons) : 0.0;
+    }
+    double framesPerSecond() const noexcept
+    {
+        return (0.0 < seconds) ? static_cast<double>(frames) / seconds : 0.0;
+    }
+};
+
+// Steering inputs and ground steering of every frame of a recording, gathered once
+// so that steering parameters can be scored without looking at the frames again.
+struct SteeringSamples
+{
+    std::vector<uint8_t> leftCone{};
+    std::vector<uint8_t> rightCone{};
+    std::vector<double> angularVeloZ{};
+    std::vector<double> angularVeloZDerivative{};
+    std::vector<double> groundSteering{};
+
+    size_t size() const noexcept
+    {
+        return leftCone.size();
+    }
+    SteeringBatch batch() const noexcept
+    {
+        return SteeringBatch{leftCone.data(), rightCone.data(), angularVeloZ.data(), angularVeloZDerivative.data(), size()};
+    }
+};
+
+// The .rec files of a directory in alphabetical order.
+std::vector<std::string> listRecordings(const std::string &directory);
+
+// Whether steering is within tolerance of a non-zero ground steering request.
+bool withinTolerance(double steering, double groundSteering, double tolerance) noexcept;
+
+// Replay a recording once and gather the steering samples of every frame for each of
+// the given colour thresholds, which all segment the same decoded frame. samples
+// ends up with one entry per thresholds entry; returns false if the recording cannot
+// be replayed or none of its frames can be decoded at the configured size. The time
+// spent is added to seconds. With a cache directory and caches for every thresholds
+// entry, only the envelopes are replayed and the cone flags are read from the caches.
+bool collectSteeringSamples(const std::string &recording, const EvaluationSettings &settings, const std::vector<ConeColourThresholds> &thresholds,
+                            std::vector<SteeringSamples> &samples, double &seconds);
+
+// Steer for every sample with the given parameters and add the frames, comparisons and
+// matches to score; steering is scratch space.
+void scoreSteering(const SteeringSamples &samples, const SteeringParameters &parameters, double tolerance, std::vector<double> &steering,
+                   RecordingScore &score);
+
+// Replay a recording offline through segmentation, blob extraction and steering and
+// compare every steering angle with the latest opendlv.proxy.GroundSteeringRequest.
+// Every call uses its own buffers, so several recordings can be evaluated in parallel.
+RecordingScore evaluateRecording(const std::string &recording, const EvaluationSettings &settings);
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "recording-replay.hpp"
+#include "opendlv-standard-message-set.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+RecordingReplay::RecordingReplay(const std::string &recording)
+    : m_recording{recording}
+    , m_player{new cluon::Player{recording, false, false}}
+{
+}
+
+bool RecordingReplay::valid() const noexcept
+{
+    return m_player->hasMoreData();
+}
+
+void RecordingReplay::dataTrigger(int32_t dataType, EnvelopeDelegate delegate)
+{
+    m_delegates[dataType] = std::move(delegate);
+}
+
+void RecordingReplay::frameTrigger(FrameDelegate delegate)
+{
+    m_frameDelegate = std::move(delegate);
+}
+
+ReplayStatistics RecordingReplay::run()
+{
+    ReplayStatistics statistics{0, 0, 0, 0.0};
+    const auto start{std::chrono::steady_clock::now()};
+    bool warned{false};
+    while (m_player->hasMoreData())
+    {
+        auto next = m_player->getNextEnvelopeToBeReplayed();
+        if (!next.first)
+        {
+            break;
+        }
+        cluon::data::Envelope &env{next.second};
+        statistics.envelopes++;
+
+        if ((opendlv::proxy::ImageReading::ID() == env.dataType()) && m_frameDelegate)
+        {
+            const int64_t sampleTimeStamp{cluon::time::toMicroseconds(env.sampleTimeStamp())};
+            const opendlv::proxy::ImageReading image{cluon::extractMessage<opendlv::proxy::ImageReading>(std::move(env))};
+            if (!m_decoder.supports(image.fourcc()))
+            {
+                if (!warned)
+                {
+                    std::cerr << m_recording << ": Cannot decode '" << image.fourcc() << "' frames." << std::endl;
+                    warned = true;
+                }
+                statistics.undecodableFrames++;
+            }
+            else if (m_decoder.decode(image.fourcc(), image.data(), image.width(), image.height(), m_frame))
+            {
+                m_frameDelegate(m_frame, sampleTimeStamp);
+                statistics.frames++;
+            }
+            else
+            {
+                statistics.undecodableFrames++;
+            }
+        }
+        else
+        {
+            auto delegate = m_delegates.find(env.dataType());
+            if (m_delegates.end() != delegate)
+            {
+                delegate->second(std::move(env));
+            }
+        }
+    }
+    statistics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return statistics;
+}
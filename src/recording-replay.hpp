@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RECORDING_REPLAY_HPP
+#define RECORDING_REPLAY_HPP
+
+#include "cluon-complete.hpp"
+#include "frame-decoder.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+// Outcome of replaying a recording.
+struct ReplayStatistics
+{
+    uint64_t envelopes;
+    uint64_t frames;
+    uint64_t undecodableFrames;
+    double seconds;
+};
+
+// Replays a .rec file offline: every envelope is read with cluon::Player in recording
+// order and handed to the delegates registered like with cluon::OD4Session::dataTrigger,
+// and every opendlv.proxy.ImageReading is decoded and handed to the frame delegate
+// together with its sample time stamp. There is no wall-clock pacing, so a recording is
+// processed as fast as the delegates allow and always with the same result.
+class RecordingReplay
+{
+  private:
+    RecordingReplay(const RecordingReplay &) = delete;
+    RecordingReplay(RecordingReplay &&) = delete;
+    RecordingReplay &operator=(const RecordingReplay &) = delete;
+    RecordingReplay &operator=(RecordingReplay &&) = delete;
+
+  public:
+    using EnvelopeDelegate = std::function<void(cluon::data::Envelope &&)>;
+    using FrameDelegate = std::function<void(const cv::Mat &, int64_t)>;
+
+    explicit RecordingReplay(const std::string &recording);
+
+    // False if the recording cannot be opened or holds no envelopes.
+    bool valid() const noexcept;
+
+    void dataTrigger(int32_t dataType, EnvelopeDelegate delegate);
+    void frameTrigger(FrameDelegate delegate);
+
+    // Replay the whole recording once. With a frame delegate, image envelopes reach it
+    // only; without one, they are not decoded and go to their data delegate, if any.
+    ReplayStatistics run();
+
+  private:
+    std::string m_recording;
+    std::unique_ptr<cluon::Player> m_player;
+    FrameDecoder m_decoder{};
+    cv::Mat m_frame{};
+    std::map<int32_t, EnvelopeDelegate> m_delegates{};
+    FrameDelegate m_frameDelegate{};
+};
+
+#endif
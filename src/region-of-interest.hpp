@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REGION_OF_INTEREST_HPP
+#define REGION_OF_INTEREST_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+// Rectangular part of a frame in pixel coordinates.
+struct RegionOfInterest
+{
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+};
+
+// Part of the frame in which cones are searched for. Everything else used to be
+// blacked out with four filled rectangles spanning (0,0)-(650,250), (0,375)-(650,500),
+// (0,0)-(100,500) and (550,0)-(650,500); as cv::rectangle includes both corners,
+// the untouched pixels are x in [101, 549] and y in [251, 374].
+constexpr RegionOfInterest CONE_REGION_OF_INTEREST{101, 251, 449, 124};
+
+// Clip a region of interest to a frame of the given size.
+inline RegionOfInterest clipRegionOfInterest(const RegionOfInterest &roi, uint32_t width, uint32_t height)
+{
+    const int32_t left{std::max<int32_t>(roi.x, 0)};
+    const int32_t top{std::max<int32_t>(roi.y, 0)};
+    const int32_t right{std::min<int32_t>(roi.x + roi.width, static_cast<int32_t>(width))};
+    const int32_t bottom{std::min<int32_t>(roi.y + roi.height, static_cast<int32_t>(height))};
+    return RegionOfInterest{left, top, std::max<int32_t>(right - left, 0), std::max<int32_t>(bottom - top, 0)};
+}
+
+#endif
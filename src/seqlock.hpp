@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Sequence lock around a small trivially copyable value, for one writer thread and
+// any number of readers. store() is wait-free: it bumps the sequence to odd, writes
+// the value and bumps it to even again. load() never blocks the writer; it copies
+// the value and retries only if a store() ran in between, which takes a handful of
+// nanoseconds. The value is kept in relaxed atomic words so that a torn read is
+// merely discarded instead of being a data race.
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock needs a trivially copyable value");
+
+  private:
+    SeqLock(const SeqLock &) = delete;
+    SeqLock(SeqLock &&) = delete;
+    SeqLock &operator=(const SeqLock &) = delete;
+    SeqLock &operator=(SeqLock &&) = delete;
+
+  public:
+    explicit SeqLock(const T &value = T{}) noexcept
+    {
+        store(value);
+    }
+
+    // Writer side only.
+    void store(const T &value) noexcept
+    {
+        uint64_t words[WORDS]{};
+        std::memcpy(words, &value, sizeof(T));
+
+        const uint64_t sequence{m_sequence.load(std::memory_order_relaxed)};
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i{0}; i < WORDS; i++)
+        {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    T load() const noexcept
+    {
+        uint64_t words[WORDS];
+        uint64_t before{0};
+        uint64_t after{0};
+        do
+        {
+            before = m_sequence.load(std::memory_order_acquire);
+            for (size_t i{0}; i < WORDS; i++)
+            {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = m_sequence.load(std::memory_order_relaxed);
+        } while ((0 != (before & 1)) || (before != after));
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    // Number of completed stores, including the one of the constructor.
+    uint64_t version() const noexcept
+    {
+        return m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+  private:
+    static constexpr size_t WORDS{(sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t)};
+
+    std::atomic<uint64_t> m_sequence{0};
+    std::atomic<uint64_t> m_words[WORDS]{};
+};
+
+#endif
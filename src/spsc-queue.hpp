@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer and one consumer thread. The
+// producer only writes the tail and the consumer only writes the head; both keep
+// a cached copy of the other side to avoid touching its cache line on every call.
+// The capacity is rounded up to a power of two and the slots are allocated once.
+template <typename T>
+class SpscQueue
+{
+  private:
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue(SpscQueue &&) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+    SpscQueue &operator=(SpscQueue &&) = delete;
+
+  public:
+    explicit SpscQueue(uint32_t capacity)
+        : m_items(roundUp(capacity))
+        , m_mask{m_items.size() - 1}
+    {
+    }
+
+    size_t capacity() const noexcept
+    {
+        return m_items.size();
+    }
+
+    // Producer side; returns false if the queue is full.
+    bool push(const T &item) noexcept
+    {
+        const uint64_t tail{m_tail.load(std::memory_order_relaxed)};
+        if (tail - m_cachedHead == m_items.size())
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == m_items.size())
+            {
+                return false;
+            }
+        }
+        m_items[tail & m_mask] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; returns false if the queue is empty.
+    bool pop(T &item) noexcept
+    {
+        const uint64_t head{m_head.load(std::memory_order_relaxed)};
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+            {
+                return false;
+            }
+        }
+        item = m_items[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    static size_t roundUp(uint32_t capacity) noexcept
+    {
+        size_t size{1};
+        while (size < capacity)
+        {
+            size *= 2;
+        }
+        return size;
+    }
+
+  private:
+    std::vector<T> m_items;
+    const uint64_t m_mask;
+    // Consumer cache line: next item to pop and the last tail seen.
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    uint64_t m_cachedTail{0};
+    // Producer cache line: next free slot and the last head seen.
+    alignas(64) std::atomic<uint64_t> m_tail{0};
+    uint64_t m_cachedHead{0};
+};
+
+#endif
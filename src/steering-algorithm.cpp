@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "steering-algorithm.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define STEERING_ALGORITHM_HAVE_AVX2
+#endif
+
+namespace
+{
+#ifdef STEERING_ALGORITHM_HAVE_AVX2
+// Count the thresholds reached in every lane with one compare per breakpoint and
+// gather the output for that count; lanes that reached none keep x.
+template <size_t N, int PREDICATE>
+__attribute__((target("avx2"))) inline __m256d mapLanes(const BreakpointTable<N> &table, __m256d x) noexcept
+{
+    __m256i count{_mm256_setzero_si256()};
+    for (size_t i{0}; i < N; i++)
+    {
+        // A true compare is all ones, i.e. -1 as an integer.
+        count = _mm256_sub_epi64(count, _mm256_castpd_si256(_mm256_cmp_pd(x, _mm256_set1_pd(table.thresholds[i]), PREDICATE)));
+    }
+    const __m256i reached{_mm256_xor_si256(_mm256_cmpeq_epi64(count, _mm256_setzero_si256()), _mm256_set1_epi64x(-1))};
+    const __m256i index{_mm256_and_si256(_mm256_sub_epi64(count, _mm256_set1_epi64x(1)), reached)};
+    return _mm256_mask_i64gather_pd(x, table.outputs, index, _mm256_castsi256_pd(reached), 8);
+}
+
+// Steering for four samples; straight is all ones in lanes with cones on both sides.
+__attribute__((target("avx2"))) inline __m256d steerLanes(__m256d angularVeloZ, __m256d derivative, __m256d straight,
+                                                         const SteeringParameters &parameters) noexcept
+{
+    const __m256d positive{_mm256_add_pd(_mm256_mul_pd(angularVeloZ, _mm256_set1_pd(parameters.positiveGain)),
+                                         _mm256_mul_pd(derivative, _mm256_set1_pd(parameters.positiveDerivativeGain)))};
+    const __m256d negative{_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(angularVeloZ, _mm256_set1_pd(parameters.negativeGain)),
+                                                       _mm256_mul_pd(derivative, _mm256_set1_pd(parameters.negativeDerivativeGain))),
+                                         _mm256_set1_pd(parameters.negativeOffset))};
+    const __m256d up{mapLanes<POSITIVE_STEERING_BREAKPOINTS.SIZE, _CMP_GE_OQ>(POSITIVE_STEERING_BREAKPOINTS,
+                                                                               _mm256_add_pd(positive, _mm256_set1_pd(parameters.positiveOffset)))};
+    const __m256d down{_mm256_andnot_pd(straight, mapLanes<NEGATIVE_STEERING_BREAKPOINTS.SIZE, _CMP_LE_OQ>(NEGATIVE_STEERING_BREAKPOINTS, negative))};
+    return _mm256_blendv_pd(down, up, _mm256_cmp_pd(positive, _mm256_setzero_pd(), _CMP_GE_OQ));
+}
+
+__attribute__((target("avx2"))) size_t steeringAlgorithmAVX2(const int32_t *direction, const double *angularVeloZ, const double *angularVeloZDerivative,
+                                                             double *steering, size_t count, const SteeringParameters &parameters) noexcept
+{
+    size_t i{0};
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i directions{_mm_loadu_si128(reinterpret_cast<const __m128i *>(direction + i))};
+        const __m256d straight{_mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpeq_epi32(directions, _mm_set1_epi32(1))))};
+        _mm256_storeu_pd(steering + i, steerLanes(_mm256_loadu_pd(angularVeloZ + i), _mm256_loadu_pd(angularVeloZDerivative + i), straight, parameters));
+    }
+    return i;
+}
+
+// Widen four cone flags to all-ones/all-zeros 64-bit lanes.
+__attribute__((target("avx2"))) inline __m256i flagLanes(const uint8_t *flags) noexcept
+{
+    int32_t bytes{0};
+    std::memcpy(&bytes, flags, sizeof(bytes));
+    const __m256i widened{_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(bytes))};
+    return _mm256_xor_si256(_mm256_cmpeq_epi64(widened, _mm256_setzero_si256()), _mm256_set1_epi64x(-1));
+}
+
+__attribute__((target("avx2"))) size_t checkSteeringAVX2(const SteeringBatch &batch, double *steering, const SteeringParameters &parameters) noexcept
+{
+    size_t i{0};
+    for (; i + 4 <= batch.count; i += 4)
+    {
+        const __m256i left{flagLanes(batch.leftCone + i)};
+        const __m256i right{flagLanes(batch.rightCone + i)};
+        const __m256d both{_mm256_castsi256_pd(_mm256_and_si256(left, right))};
+        const __m256d any{_mm256_castsi256_pd(_mm256_or_si256(left, right))};
+        const __m256d angle{steerLanes(_mm256_loadu_pd(batch.angularVeloZ + i), _mm256_loadu_pd(batch.angularVeloZDerivative + i), both, parameters)};
+        _mm256_storeu_pd(steering + i, _mm256_and_pd(angle, any));
+    }
+    return i;
+}
+
+bool cpuHasAVX2() noexcept
+{
+    static const bool HAS_AVX2{0 != __builtin_cpu_supports("avx2")};
+    return HAS_AVX2;
+}
+#endif
+} // namespace
+
+double steeringAlgorithm(int32_t direction, double angularVeloZ, double angularVeloZDerivative, const SteeringParameters &parameters) noexcept
+{
+    // Calculate the steering angle based on angular velocity and its derivative
+    const double positive{(angularVeloZ * parameters.positiveGain) + (angularVeloZDerivative * parameters.positiveDerivativeGain)};
+    const double negative{(angularVeloZ * parameters.negativeGain) + (angularVeloZDerivative * parameters.negativeDerivativeGain) + parameters.negativeOffset};
+
+    // Both sides are evaluated and selected afterwards, which compiles to conditional moves.
+    const double up{mapAtLeast(POSITIVE_STEERING_BREAKPOINTS, positive + parameters.positiveOffset)};
+    const double down{(1 == direction) ? 0.0 : mapAtMost(NEGATIVE_STEERING_BREAKPOINTS, negative)};
+    return (positive >= 0) ? up : down;
+}
+
+void steeringAlgorithm(const int32_t *direction, const double *angularVeloZ, const double *angularVeloZDerivative, double *steering, size_t count,
+                       const SteeringParameters &parameters) noexcept
+{
+    size_t i{0};
+#ifdef STEERING_ALGORITHM_HAVE_AVX2
+    if (cpuHasAVX2())
+    {
+        i = steeringAlgorithmAVX2(direction, angularVeloZ, angularVeloZDerivative, steering, count, parameters);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        steering[i] = steeringAlgorithm(direction[i], angularVeloZ[i], angularVeloZDerivative[i], parameters);
+    }
+}
+
+double checkSteering(bool leftCone, bool rightCone, double angularVeloZ, double angularVeloZDerivative, const SteeringParameters &parameters) noexcept
+{
+    // Both cones detected: direction 1; only the right or only the left one: the full model
+    const int32_t direction{(leftCone && rightCone) ? 1 : (rightCone ? 0 : 2)};
+    const double steering{steeringAlgorithm(direction, angularVeloZ, angularVeloZDerivative, parameters)};
+    return (leftCone || rightCone) ? steering : 0.0;
+}
+
+void checkSteering(const SteeringBatch &batch, double *steering, const SteeringParameters &parameters) noexcept
+{
+    size_t i{0};
+#ifdef STEERING_ALGORITHM_HAVE_AVX2
+    if (cpuHasAVX2())
+    {
+        i = checkSteeringAVX2(batch, steering, parameters);
+    }
+#endif
+    for (; i < batch.count; i++)
+    {
+        steering[i] = checkSteering(0 != batch.leftCone[i], 0 != batch.rightCone[i], batch.angularVeloZ[i], batch.angularVeloZDerivative[i], parameters);
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STEERING_ALGORITHM_HPP
+#define STEERING_ALGORITHM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Output ladder of one sign of the steering model. On the positive side a value at or
+// above thresholds[i] becomes outputs[i], on the negative side one at or below it;
+// the furthest threshold reached wins and a value short of the first one passes through.
+template <size_t N>
+struct BreakpointTable
+{
+    static constexpr size_t SIZE{N};
+    double thresholds[N];
+    double outputs[N];
+};
+
+template <size_t N>
+constexpr size_t BreakpointTable<N>::SIZE;
+
+// Breakpoints found through testing on the recordings.
+constexpr BreakpointTable<8> POSITIVE_STEERING_BREAKPOINTS{{0.02, 0.05, 0.07, 0.12, 0.16, 0.18, 0.19, 0.23},
+                                                           {0.03, 0.06, 0.07, 0.086, 0.17, 0.19, 0.22, 0.23}};
+constexpr BreakpointTable<6> NEGATIVE_STEERING_BREAKPOINTS{{-0.07, -0.12, -0.16, -0.18, -0.19, -0.23},
+                                                           {-0.11, -0.17, -0.209, -0.222, -0.23, -0.26}};
+
+// Thresholds must move away from zero for the count of thresholds reached to be the ladder index.
+template <size_t N>
+constexpr bool isIncreasing(const BreakpointTable<N> &table, double sign)
+{
+    for (size_t i{1}; i < N; i++)
+    {
+        if (!(sign * table.thresholds[i - 1] < sign * table.thresholds[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(isIncreasing(POSITIVE_STEERING_BREAKPOINTS, 1.0), "positive thresholds must ascend");
+static_assert(isIncreasing(NEGATIVE_STEERING_BREAKPOINTS, -1.0), "negative thresholds must descend");
+
+// Linear yaw-rate model in front of the ladders: gain * yaw rate + derivative gain *
+// derivative, then the offset is added. The positive model also decides the side.
+struct SteeringParameters
+{
+    double positiveGain;
+    double positiveDerivativeGain;
+    double positiveOffset;
+    double negativeGain;
+    double negativeDerivativeGain;
+    double negativeOffset;
+};
+
+constexpr SteeringParameters DEFAULT_STEERING_PARAMETERS{0.002879, 0.00097, 0.04, 0.001879, 0.00091, -0.04};
+
+// Apply one ladder to a single value without branches: count the thresholds reached
+// and pick the output by that count.
+template <size_t N>
+inline double mapAtLeast(const BreakpointTable<N> &table, double x) noexcept
+{
+    uint32_t count{0};
+    for (size_t i{0}; i < N; i++)
+    {
+        count += (x >= table.thresholds[i]) ? 1 : 0;
+    }
+    const double mapped{table.outputs[count - ((0 != count) ? 1 : 0)]};
+    return (0 == count) ? x : mapped;
+}
+
+template <size_t N>
+inline double mapAtMost(const BreakpointTable<N> &table, double x) noexcept
+{
+    uint32_t count{0};
+    for (size_t i{0}; i < N; i++)
+    {
+        count += (x <= table.thresholds[i]) ? 1 : 0;
+    }
+    const double mapped{table.outputs[count - ((0 != count) ? 1 : 0)]};
+    return (0 == count) ? x : mapped;
+}
+
+// Steering angle for the yaw rate and its derivative. direction is 1 with cones on
+// both sides, which keeps the car straight instead of steering to the negative side.
+double steeringAlgorithm(int32_t direction, double angularVeloZ, double angularVeloZDerivative,
+                         const SteeringParameters &parameters = DEFAULT_STEERING_PARAMETERS) noexcept;
+
+// The same for count samples at once; uses AVX2 for four samples per step when the CPU supports it.
+void steeringAlgorithm(const int32_t *direction, const double *angularVeloZ, const double *angularVeloZDerivative, double *steering, size_t count,
+                       const SteeringParameters &parameters = DEFAULT_STEERING_PARAMETERS) noexcept;
+
+// Steering angle for the cones seen in a frame: cones on both sides keep the car from
+// steering to the negative side, a single side uses the full model and without any
+// cones the wheels are centred.
+double checkSteering(bool leftCone, bool rightCone, double angularVeloZ, double angularVeloZDerivative,
+                     const SteeringParameters &parameters = DEFAULT_STEERING_PARAMETERS) noexcept;
+
+// Structure-of-arrays input of count frames for evaluating checkSteering() in bulk;
+// the cone flags are 0 or non-zero bytes.
+struct SteeringBatch
+{
+    const uint8_t *leftCone;
+    const uint8_t *rightCone;
+    const double *angularVeloZ;
+    const double *angularVeloZDerivative;
+    size_t count;
+};
+
+// checkSteering() for every frame of the batch into steering[0, batch.count); uses
+// AVX2 for four frames per step when the CPU supports it.
+void checkSteering(const SteeringBatch &batch, double *steering, const SteeringParameters &parameters = DEFAULT_STEERING_PARAMETERS) noexcept;
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Include the single-file, header-only middleware libcluon for parsing the command line
+#include "cluon-complete.hpp"
+// Offline replay and scoring of recordings against the recorded ground steering
+#include "recording-evaluation.hpp"
+// Steering parameters and colour thresholds as printed by the tuner
+#include "parameter-flags.hpp"
+// Recordings are evaluated in parallel, one per task
+#include "thread-pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (0 == commandlineArguments.count("recordings"))
+    {
+        std::cerr << argv[0] << " replays every .rec file of a directory offline and scores the steering against the recorded GroundSteeringRequest." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --recordings=<directory> [--width=<w>] [--height=<h>] [--tolerance=<fraction>] [--threads=<n>] [--cache=<directory>] [--segmentation=<method>] [--lut-bits=<bits>] [--yaw-filter=<filter>] [--<parameter>=<value> ...]" << std::endl;
+        std::cerr << "         --recordings:   directory with the .rec files to evaluate" << std::endl;
+        std::cerr << "         --width:        width of the frames (default 640)" << std::endl;
+        std::cerr << "         --height:       height of the frames (default 480)" << std::endl;
+        std::cerr << "         --tolerance:    accepted deviation from the ground steering (default 0.25)" << std::endl;
+        std::cerr << "         --cache:        directory keeping the blobs and cones found in every frame, so that later runs only redo the steering" << std::endl;
+        std::cerr << "         --threads:      recordings evaluated at once (default: all cores)" << std::endl;
+        std::cerr << "         --segmentation: hsv (default) or lut (precomputed colour lookup table)" << std::endl;
+        std::cerr << "         --lut-bits:     bits per colour channel of the lookup table, 4 to 8 (default 6)" << std::endl;
+        std::cerr << "         --yaw-filter:   yaw-rate derivative: sample (default), difference, lowpass, savitzky-golay or alpha-beta" << std::endl;
+        std::cerr << "         steering parameters:";
+        for (const auto &flag : STEERING_PARAMETER_FLAGS)
+        {
+            std::cerr << " --" << flag.name;
+        }
+        std::cerr << std::endl << "         colour thresholds:  ";
+        for (const auto &flag : THRESHOLD_FLAGS)
+        {
+            std::cerr << " --" << flag.name;
+        }
+        std::cerr << std::endl;
+        std::cerr << "Example: " << argv[0] << " --recordings=recordings --threads=4" << std::endl;
+        return retCode;
+    }
+
+    EvaluationSettings settings;
+    if (0 != commandlineArguments.count("width"))
+    {
+        settings.width = static_cast<uint32_t>(std::stoi(commandlineArguments["width"]));
+    }
+    if (0 != commandlineArguments.count("height"))
+    {
+        settings.height = static_cast<uint32_t>(std::stoi(commandlineArguments["height"]));
+    }
+    if (0 != commandlineArguments.count("tolerance"))
+    {
+        settings.tolerance = std::stod(commandlineArguments["tolerance"]);
+    }
+    if (0 != commandlineArguments.count("cache"))
+    {
+        settings.cacheDirectory = commandlineArguments["cache"];
+    }
+    if ((0 != commandlineArguments.count("yaw-filter")) && !parseYawRateFilter(commandlineArguments["yaw-filter"], settings.yawRateFilter.filter))
+    {
+        std::cerr << argv[0] << ": Unknown yaw-rate filter '" << commandlineArguments["yaw-filter"] << "'." << std::endl;
+        return retCode;
+    }
+    std::string invalidFlag;
+    if (!parseSteeringParameters(commandlineArguments, settings.steering, invalidFlag) ||
+        !parseConeColourThresholds(commandlineArguments, settings.thresholds, invalidFlag))
+    {
+        std::cerr << argv[0] << ": Invalid value '" << commandlineArguments[invalidFlag] << "' for --" << invalidFlag << "." << std::endl;
+        return retCode;
+    }
+    SegmentationMethod segmentation{SegmentationMethod::Hsv};
+    if ((0 != commandlineArguments.count("segmentation")) && !parseSegmentationMethod(commandlineArguments["segmentation"], segmentation))
+    {
+        std::cerr << argv[0] << ": Unknown segmentation '" << commandlineArguments["segmentation"] << "'." << std::endl;
+        return retCode;
+    }
+    uint32_t lutBits{6};
+    if ((0 != commandlineArguments.count("lut-bits")) && !parseLookupTableBits(commandlineArguments["lut-bits"], lutBits))
+    {
+        std::cerr << argv[0] << ": Invalid lookup table bits '" << commandlineArguments["lut-bits"] << "'." << std::endl;
+        return retCode;
+    }
+    std::unique_ptr<ConeColourClassifier> classifier;
+    if (SegmentationMethod::Lut == segmentation)
+    {
+        classifier.reset(new ConeColourClassifier{lutBits, settings.thresholds});
+        settings.classifiers.push_back(classifier.get());
+    }
+    const uint32_t THREADS{(0 != commandlineArguments.count("threads")) ? static_cast<uint32_t>(std::max(std::stoi(commandlineArguments["threads"]), 1))
+                                                                           : std::max(std::thread::hardware_concurrency(), 1u)};
+
+    const std::vector<std::string> recordings{listRecordings(commandlineArguments["recordings"])};
+    if (recordings.empty())
+    {
+        std::cerr << argv[0] << ": No .rec files in '" << commandlineArguments["recordings"] << "'." << std::endl;
+        return retCode;
+    }
+
+    // Every task replays one recording with its own buffers; the caller is one of the threads.
+    std::vector<RecordingScore> scores(recordings.size());
+    ThreadPool pool{THREADS - 1};
+    const auto start{std::chrono::steady_clock::now()};
+    pool.run(static_cast<uint32_t>(recordings.size()), [&](uint32_t i) { scores[i] = evaluateRecording(recordings[i], settings); });
+    const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+
+    RecordingScore total{true, 0, 0, 0, seconds};
+    bool allReplayed{true};
+    std::cout << std::fixed << std::setprecision(1);
+    for (size_t i{0}; i < recordings.size(); i++)
+    {
+        const RecordingScore &score{scores[i]};
+        if (!score.valid)
+        {
+            std::cout << recordings[i] << ": cannot be replayed" << std::endl;
+            allReplayed = false;
+            continue;
+        }
+        std::cout << recordings[i] << ": " << 100.0 * score.accuracy() << "% of " << score.comparisons << " frames correct, " << score.frames << " frames at "
+                  << score.framesPerSecond() << " frames/s" << std::endl;
+        total.frames += score.frames;
+        total.comparisons += score.comparisons;
+        total.matches += score.matches;
+    }
+    std::cout << "total: " << 100.0 * total.accuracy() << "% of " << total.comparisons << " frames correct, " << total.frames << " frames of "
+              << recordings.size() << " recordings in " << seconds << " s at " << total.framesPerSecond() << " frames/s on " << THREADS << " threads" << std::endl;
+
+    // A recording that cannot be replayed, for example h264 without OpenH264, fails the evaluation.
+    retCode = allReplayed ? 0 : 1;
+    return retCode;
+}
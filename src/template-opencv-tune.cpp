@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Include the single-file, header-only middleware libcluon for parsing the command line
+#include "cluon-complete.hpp"
+// Offline replay, steering samples and scoring against the recorded ground steering
+#include "recording-evaluation.hpp"
+// Names of the steering parameters and colour thresholds that can be swept
+#include "parameter-flags.hpp"
+// Recordings and parameter sets are evaluated in parallel, one per task
+#include "thread-pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// A single value or <first>:<last>:<steps> with steps evenly spaced values including both ends.
+bool parseSweep(const std::string &text, std::vector<double> &values)
+{
+    values.clear();
+    try
+    {
+        const size_t first{text.find(':')};
+        if (std::string::npos == first)
+        {
+            values.push_back(std::stod(text));
+            return true;
+        }
+        const size_t second{text.find(':', first + 1)};
+        if (std::string::npos == second)
+        {
+            return false;
+        }
+        const double begin{std::stod(text.substr(0, first))};
+        const double end{std::stod(text.substr(first + 1, second - first - 1))};
+        const int32_t steps{std::stoi(text.substr(second + 1))};
+        if (steps < 2)
+        {
+            return false;
+        }
+        for (int32_t i{0}; i < steps; i++)
+        {
+            values.push_back(begin + (end - begin) * i / (steps - 1));
+        }
+        return true;
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+}
+
+// Every combination of the values of all dimensions applied to base.
+template <typename T, typename Apply>
+std::vector<T> combinations(const T &base, const std::vector<std::vector<double>> &values, Apply apply)
+{
+    std::vector<T> candidates{base};
+    for (size_t dimension{0}; dimension < values.size(); dimension++)
+    {
+        std::vector<T> next;
+        for (const T &candidate : candidates)
+        {
+            for (const double value : values[dimension])
+            {
+                T t{candidate};
+                apply(t, dimension, value);
+                next.push_back(t);
+            }
+        }
+        candidates.swap(next);
+    }
+    return candidates;
+}
+} // namespace
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (0 == commandlineArguments.count("recordings"))
+    {
+        std::cerr << argv[0] << " sweeps steering parameters and colour thresholds over a directory of recordings and reports the most accurate sets." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --recordings=<directory> [--<parameter>=<value>|<first>:<last>:<steps> ...] [--width=<w>] [--height=<h>] [--tolerance=<fraction>] [--threads=<n>] [--cache=<directory>] [--top=<n>] [--segmentation=<method>] [--lut-bits=<bits>] [--yaw-filter=<filter>]" << std::endl;
+        std::cerr << "         --recordings:   directory with the .rec files to tune on" << std::endl;
+        std::cerr << "         --width:        width of the frames (default 640)" << std::endl;
+        std::cerr << "         --height:       height of the frames (default 480)" << std::endl;
+        std::cerr << "         --tolerance:    accepted deviation from the ground steering (default 0.25)" << std::endl;
+        std::cerr << "         --cache:        directory keeping the blobs and cones found in every frame, so that later runs only redo the steering" << std::endl;
+        std::cerr << "         --threads:      tasks run at once (default: all cores)" << std::endl;
+        std::cerr << "         --top:          parameter sets reported (default 10)" << std::endl;
+        std::cerr << "         --segmentation: hsv (default) or lut (precomputed colour lookup table)" << std::endl;
+        std::cerr << "         --lut-bits:     bits per colour channel of the lookup table, 4 to 8 (default 6)" << std::endl;
+        std::cerr << "         --yaw-filter:   yaw-rate derivative: sample (default), difference, lowpass, savitzky-golay or alpha-beta" << std::endl;
+        std::cerr << "         steering parameters:";
+        for (const auto &flag : STEERING_PARAMETER_FLAGS)
+        {
+            std::cerr << " --" << flag.name;
+        }
+        std::cerr << std::endl << "         colour thresholds:  ";
+        for (const auto &flag : THRESHOLD_FLAGS)
+        {
+            std::cerr << " --" << flag.name;
+        }
+        std::cerr << std::endl;
+        std::cerr << "Example: " << argv[0] << " --recordings=recordings --positive-gain=0.002:0.004:11 --blue-lower-s=30:70:5" << std::endl;
+        return retCode;
+    }
+
+    EvaluationSettings settings;
+    if (0 != commandlineArguments.count("width"))
+    {
+        settings.width = static_cast<uint32_t>(std::stoi(commandlineArguments["width"]));
+    }
+    if (0 != commandlineArguments.count("height"))
+    {
+        settings.height = static_cast<uint32_t>(std::stoi(commandlineArguments["height"]));
+    }
+    if (0 != commandlineArguments.count("tolerance"))
+    {
+        settings.tolerance = std::stod(commandlineArguments["tolerance"]);
+    }
+    if (0 != commandlineArguments.count("cache"))
+    {
+        settings.cacheDirectory = commandlineArguments["cache"];
+    }
+    if ((0 != commandlineArguments.count("yaw-filter")) && !parseYawRateFilter(commandlineArguments["yaw-filter"], settings.yawRateFilter.filter))
+    {
+        std::cerr << argv[0] << ": Unknown yaw-rate filter '" << commandlineArguments["yaw-filter"] << "'." << std::endl;
+        return retCode;
+    }
+    SegmentationMethod segmentation{SegmentationMethod::Hsv};
+    if ((0 != commandlineArguments.count("segmentation")) && !parseSegmentationMethod(commandlineArguments["segmentation"], segmentation))
+    {
+        std::cerr << argv[0] << ": Unknown segmentation '" << commandlineArguments["segmentation"] << "'." << std::endl;
+        return retCode;
+    }
+    uint32_t lutBits{6};
+    if ((0 != commandlineArguments.count("lut-bits")) && !parseLookupTableBits(commandlineArguments["lut-bits"], lutBits))
+    {
+        std::cerr << argv[0] << ": Invalid lookup table bits '" << commandlineArguments["lut-bits"] << "'." << std::endl;
+        return retCode;
+    }
+    const uint32_t THREADS{(0 != commandlineArguments.count("threads")) ? static_cast<uint32_t>(std::max(std::stoi(commandlineArguments["threads"]), 1))
+                                                                           : std::max(std::thread::hardware_concurrency(), 1u)};
+    const size_t TOP{(0 != commandlineArguments.count("top")) ? static_cast<size_t>(std::max(std::stoi(commandlineArguments["top"]), 1)) : 10};
+
+    // Values of every dimension; those not given keep their current value.
+    std::vector<std::vector<double>> steeringValues;
+    for (const auto &flag : STEERING_PARAMETER_FLAGS)
+    {
+        steeringValues.push_back({settings.steering.*flag.member});
+        if ((0 != commandlineArguments.count(flag.name)) && !parseSweep(commandlineArguments[flag.name], steeringValues.back()))
+        {
+            std::cerr << argv[0] << ": Invalid sweep '" << commandlineArguments[flag.name] << "' for --" << flag.name << "." << std::endl;
+            return retCode;
+        }
+    }
+    std::vector<std::vector<double>> thresholdValues;
+    for (const auto &flag : THRESHOLD_FLAGS)
+    {
+        thresholdValues.push_back({static_cast<double>(settings.thresholds.*flag.colour.*flag.bound)});
+        if ((0 != commandlineArguments.count(flag.name)) && !parseSweep(commandlineArguments[flag.name], thresholdValues.back()))
+        {
+            std::cerr << argv[0] << ": Invalid sweep '" << commandlineArguments[flag.name] << "' for --" << flag.name << "." << std::endl;
+            return retCode;
+        }
+    }
+    const std::vector<SteeringParameters> steeringCandidates{
+        combinations(settings.steering, steeringValues, [](SteeringParameters &p, size_t d, double v) { p.*STEERING_PARAMETER_FLAGS[d].member = v; })};
+    const std::vector<ConeColourThresholds> thresholdCandidates{combinations(settings.thresholds, thresholdValues, [](ConeColourThresholds &t, size_t d, double v) {
+        t.*THRESHOLD_FLAGS[d].colour.*THRESHOLD_FLAGS[d].bound = static_cast<uint8_t>(std::min(std::max(std::lround(v), 0l), 255l));
+    })};
+
+    const std::vector<std::string> recordings{listRecordings(commandlineArguments["recordings"])};
+    if (recordings.empty())
+    {
+        std::cerr << argv[0] << ": No .rec files in '" << commandlineArguments["recordings"] << "'." << std::endl;
+        return retCode;
+    }
+    std::clog << argv[0] << ": " << thresholdCandidates.size() << " colour thresholds x " << steeringCandidates.size() << " steering parameter sets over "
+              << recordings.size() << " recordings." << std::endl;
+
+    ThreadPool pool{THREADS - 1};
+    const auto start{std::chrono::steady_clock::now()};
+
+    // With lookup tables every colour threshold candidate needs its own, built once up front.
+    std::vector<std::unique_ptr<ConeColourClassifier>> classifiers(thresholdCandidates.size());
+    if (SegmentationMethod::Lut == segmentation)
+    {
+        pool.run(static_cast<uint32_t>(classifiers.size()),
+                 [&](uint32_t i) { classifiers[i].reset(new ConeColourClassifier{lutBits, thresholdCandidates[i]}); });
+        for (const auto &classifier : classifiers)
+        {
+            settings.classifiers.push_back(classifier.get());
+        }
+    }
+
+    // Every recording is decoded once; each frame is segmented once per colour threshold
+    // candidate and the resulting cone flags are kept for all steering candidates.
+    std::vector<std::vector<SteeringSamples>> samples(recordings.size());
+    std::vector<double> replaySeconds(recordings.size(), 0.0);
+    std::vector<uint8_t> replayed(recordings.size(), 0);
+    pool.run(static_cast<uint32_t>(recordings.size()), [&](uint32_t i) {
+        replayed[i] = collectSteeringSamples(recordings[i], settings, thresholdCandidates, samples[i], replaySeconds[i]) ? 1 : 0;
+    });
+    const double segmentationSeconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+    // Tuning on a subset of the recordings would report parameters for data nobody asked for.
+    for (size_t i{0}; i < recordings.size(); i++)
+    {
+        if (0 == replayed[i])
+        {
+            std::cerr << argv[0] << ": Cannot replay '" << recordings[i] << "'." << std::endl;
+            return retCode;
+        }
+    }
+
+    // Score every combination over all recordings from the cached samples alone.
+    struct Result
+    {
+        size_t thresholds;
+        size_t steering;
+        RecordingScore score;
+    };
+    std::vector<Result> results(thresholdCandidates.size() * steeringCandidates.size());
+    pool.run(static_cast<uint32_t>(results.size()), [&](uint32_t i) {
+        Result &result{results[i]};
+        result.thresholds = i / steeringCandidates.size();
+        result.steering = i % steeringCandidates.size();
+        result.score = RecordingScore{true, 0, 0, 0, 0.0};
+        std::vector<double> steering;
+        for (const auto &recording : samples)
+        {
+            if (!recording.empty())
+            {
+                scoreSteering(recording[result.thresholds], steeringCandidates[result.steering], settings.tolerance, steering, result.score);
+            }
+        }
+    });
+    const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+
+    // Best first; equally accurate sets keep their sweep order.
+    std::stable_sort(results.begin(), results.end(), [](const Result &a, const Result &b) { return a.score.accuracy() > b.score.accuracy(); });
+    for (size_t i{0}; i < std::min(TOP, results.size()); i++)
+    {
+        const Result &result{results[i]};
+        std::cout << 100.0 * result.score.accuracy() << "% of " << result.score.comparisons << " frames:"
+                  << describeParameters(thresholdCandidates[result.thresholds], steeringCandidates[result.steering]) << std::endl;
+    }
+    std::clog << argv[0] << ": Segmented in " << segmentationSeconds << " s, scored " << results.size() << " parameter sets in " << seconds - segmentationSeconds
+              << " s on " << THREADS << " threads." << std::endl;
+
+    retCode = 0;
+    return retCode;
+}
@@ -19,371 +19,392 @@
 #include "cluon-complete.hpp"
 // Include the OpenDLV Standard Message Set that contains messages that are usually exchanged for automotive or robotic applications
 #include "opendlv-standard-message-set.hpp"
+// Hands out frames from the shared memory area in the selected acquisition mode
+#include "frame-acquisition.hpp"
+// Fused HSV conversion and colour thresholding for the cone masks
+#include "hsv-threshold.hpp"
+// Table-driven colour segmentation without HSV conversion
+#include "cone-classifier.hpp"
+// Per-frame buffers reused across frames and the heap allocation counter guarding them
+#include "frame-workspace.hpp"
+#include "allocation-counter.hpp"
+// Segmentation, morphology, blob extraction and steering shared by the serial loop and the pipeline
+#include "cone-perception.hpp"
+// Acquisition, blob extraction and output as pipelined threads pinned to cores
+#include "vision-pipeline.hpp"
+#include "thread-affinity.hpp"
+// Row bands of one frame processed in parallel on a persistent thread pool
+#include "banded-perception.hpp"
+// Offline replay of .rec files without an OD4Session or shared memory, and scoring against the ground steering
+#include "recording-replay.hpp"
+#include "recording-evaluation.hpp"
+// Steering parameters and colour thresholds given on the command line, as printed by the tuner
+#include "parameter-flags.hpp"
+// Yaw rate shared between the network and the vision threads without locks
+#include "yaw-rate-state.hpp"
+// Time-aware filtering of the yaw rate and its derivative
+#include "yaw-rate-estimator.hpp"
 
 // Include the GUI and image processing header files from OpenCV
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
-// Function to calculate the steering angle 
-double steeringAlgorithm(int direction, double steering, double angularVeloZ, double angularVeloZDerivative)
+int32_t main(int32_t argc, char **argv)
 {
-    double steeringAngle = steering; // Initial steering angle
 
-    steeringAngle = (angularVeloZ * 0.002879) + (angularVeloZDerivative * 0.00097);
-    // Calculate the steering angle based on angular velocity and its derivative
+    int32_t retCode{1};
 
+    double steeringAngle = 0;
 
-    if (steeringAngle >= 0)
+    // Parse the command line parameters as we require the user to specify some mandatory information on startup.
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (((0 == commandlineArguments.count("rec")) &&
+         ((0 == commandlineArguments.count("cid")) ||
+          (0 == commandlineArguments.count("name")))) ||
+        (0 == commandlineArguments.count("width")) ||
+        (0 == commandlineArguments.count("height")))
     {
-        steeringAngle = steeringAngle + 0.04;
-        if (steeringAngle >= 0.23)
+        std::cerr << argv[0] << " attaches to a shared memory area containing an ARGB image." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --cid=<OD4 session> --name=<name of shared memory area> [--rec=<recording>] [--bands=<n>] [--acquisition=<mode>] [--segmentation=<method>] [--lut-bits=<bits>] [--pipeline] [--cores=<list>] [--yaw-filter=<filter>] [--<parameter>=<value> ...] [--verbose]" << std::endl;
+        std::cerr << "         --cid:          CID of the OD4Session to send and receive messages" << std::endl;
+        std::cerr << "         --name:         name of the shared memory area to attach" << std::endl;
+        std::cerr << "         --rec:          replay a .rec file offline as fast as possible instead of --cid and --name" << std::endl;
+        std::cerr << "         --width:        width of the frame" << std::endl;
+        std::cerr << "         --height:       height of the frame" << std::endl;
+        std::cerr << "         --bands:        number of row bands every frame is split into for parallel processing (default 1)" << std::endl;
+        std::cerr << "         --acquisition:  copy (default), direct (process while locked) or ring (copy region of interest only)" << std::endl;
+        std::cerr << "         --segmentation: hsv (default) or lut (precomputed colour lookup table)" << std::endl;
+        std::cerr << "         --lut-bits:     bits per colour channel of the lookup table, 4 to 8 (default 6)" << std::endl;
+        std::cerr << "         --pipeline:     acquire, find blobs and steer on separate threads, dropping stale frames" << std::endl;
+        std::cerr << "         --cores:        comma separated cores for the acquire, blobs and output threads of the pipeline" << std::endl;
+        std::cerr << "         --yaw-filter:   yaw-rate derivative: sample (default), difference, lowpass, savitzky-golay or alpha-beta" << std::endl;
+        std::cerr << "         --yaw-window:   readings in the savitzky-golay fit, 2 to 32 (default 5)" << std::endl;
+        std::cerr << "         --yaw-cutoff:   cut-off frequency of the lowpass filter in Hz (default 4)" << std::endl;
+        std::cerr << "         --yaw-alpha:    alpha gain of the alpha-beta filter (default 0.5)" << std::endl;
+        std::cerr << "         --yaw-beta:     beta gain of the alpha-beta filter (default 0.1)" << std::endl;
+        std::cerr << "         steering parameters:";
+        for (const auto &flag : STEERING_PARAMETER_FLAGS)
         {
-            steeringAngle = 0.23;
+            std::cerr << " --" << flag.name;
         }
-        else if (steeringAngle >= 0.19)
+        std::cerr << std::endl << "         colour thresholds:  ";
+        for (const auto &flag : THRESHOLD_FLAGS)
         {
-            steeringAngle = 0.22;
+            std::cerr << " --" << flag.name;
         }
-        else if (steeringAngle >= 0.18)
+        std::cerr << std::endl;
+        std::cerr << "Example: " << argv[0] << " --cid=253 --name=img --width=640 --height=480 --verbose" << std::endl;
+        std::cerr << "         " << argv[0] << " --rec=CID-140-recording-2020-03-18_144821-selection.rec --width=640 --height=480" << std::endl;
+    }
+    else
+    {
+        // Extract the values from the command line parameters
+        const std::string NAME{commandlineArguments["name"]};
+        const std::string RECORDING{commandlineArguments["rec"]};
+        // Title of the window showing the frames with --verbose.
+        const std::string WINDOW{RECORDING.empty() ? NAME : RECORDING};
+        const uint32_t WIDTH{static_cast<uint32_t>(std::stoi(commandlineArguments["width"]))};
+        const uint32_t HEIGHT{static_cast<uint32_t>(std::stoi(commandlineArguments["height"]))};
+        const uint32_t BANDS{(0 != commandlineArguments.count("bands")) ? static_cast<uint32_t>(std::max(std::stoi(commandlineArguments["bands"]), 1)) : 1};
+        const bool VERBOSE{commandlineArguments.count("verbose") != 0};
+        AcquisitionMode acquisitionMode{AcquisitionMode::Copy};
+        if ((0 != commandlineArguments.count("acquisition")) && !parseAcquisitionMode(commandlineArguments["acquisition"], acquisitionMode))
         {
-            steeringAngle = 0.19;
+            std::cerr << argv[0] << ": Unknown acquisition mode '" << commandlineArguments["acquisition"] << "'." << std::endl;
+            return retCode;
         }
-        else if (steeringAngle >= 0.16)
+        SegmentationMethod segmentation{SegmentationMethod::Hsv};
+        if ((0 != commandlineArguments.count("segmentation")) && !parseSegmentationMethod(commandlineArguments["segmentation"], segmentation))
         {
-            steeringAngle = 0.17;
+            std::cerr << argv[0] << ": Unknown segmentation '" << commandlineArguments["segmentation"] << "'." << std::endl;
+            return retCode;
         }
-        else if (steeringAngle >= 0.12)
+        uint32_t lutBits{6};
+        if ((0 != commandlineArguments.count("lut-bits")) && !parseLookupTableBits(commandlineArguments["lut-bits"], lutBits))
         {
-            steeringAngle = 0.086;
+            std::cerr << argv[0] << ": Invalid lookup table bits '" << commandlineArguments["lut-bits"] << "'." << std::endl;
+            return retCode;
         }
-        else if (steeringAngle >= 0.07)
+        const bool USE_LUT{SegmentationMethod::Lut == segmentation};
+        const uint32_t LUT_BITS{lutBits};
+        const bool PIPELINE{commandlineArguments.count("pipeline") != 0};
+        YawRateFilterSettings yawRateFilter;
+        if ((0 != commandlineArguments.count("yaw-filter")) && !parseYawRateFilter(commandlineArguments["yaw-filter"], yawRateFilter.filter))
         {
-            steeringAngle = 0.07;
+            std::cerr << argv[0] << ": Unknown yaw-rate filter '" << commandlineArguments["yaw-filter"] << "'." << std::endl;
+            return retCode;
         }
-        else if (steeringAngle >= 0.05)
+        if (0 != commandlineArguments.count("yaw-window"))
         {
-            steeringAngle = 0.06;
+            yawRateFilter.window = static_cast<uint32_t>(std::max(std::stoi(commandlineArguments["yaw-window"]), 2));
         }
-        else if (steeringAngle >= 0.02)
+        if (0 != commandlineArguments.count("yaw-cutoff"))
         {
-            steeringAngle = 0.03;
+            yawRateFilter.cutoffFrequency = std::stod(commandlineArguments["yaw-cutoff"]);
         }
-    }
-    else if (direction == 1) // Adjusting steering angle based on direction
-    {
-        steeringAngle = 0;
-    }
-    else // Adjusting steering angle for negative values
-    {
-        steeringAngle = (angularVeloZ * 0.001879) + (angularVeloZDerivative * 0.00091); 
-        steeringAngle = steeringAngle - 0.04;
-        if (steeringAngle <= -0.23)
+        if (0 != commandlineArguments.count("yaw-alpha"))
         {
-            steeringAngle = -0.26;
+            yawRateFilter.alpha = std::stod(commandlineArguments["yaw-alpha"]);
         }
-        else if (steeringAngle <= -0.19)
+        if (0 != commandlineArguments.count("yaw-beta"))
         {
-            steeringAngle = -0.23;
+            yawRateFilter.beta = std::stod(commandlineArguments["yaw-beta"]);
         }
-        else if (steeringAngle <= -0.18)
+        std::vector<int32_t> CORES;
+        if ((0 != commandlineArguments.count("cores")) && !parseCoreList(commandlineArguments["cores"], CORES))
         {
-            steeringAngle = -0.222;
+            std::cerr << argv[0] << ": Invalid core list '" << commandlineArguments["cores"] << "'." << std::endl;
+            return retCode;
         }
-        else if (steeringAngle <= -0.16)
+        // HSV values for the blue and yellow cones and the steering model; the defaults unless tuned.
+        ConeColourThresholds thresholds{};
+        SteeringParameters steeringParameters{DEFAULT_STEERING_PARAMETERS};
+        std::string invalidFlag;
+        if (!parseConeColourThresholds(commandlineArguments, thresholds, invalidFlag) ||
+            !parseSteeringParameters(commandlineArguments, steeringParameters, invalidFlag))
         {
-            steeringAngle = -0.209;
+            std::cerr << argv[0] << ": Invalid value '" << commandlineArguments[invalidFlag] << "' for --" << invalidFlag << "." << std::endl;
+            return retCode;
         }
-        else if (steeringAngle <= -0.12)
+
+        opendlv::proxy::GroundSteeringRequest gsr;
+        std::mutex gsrMutex;
+        auto onGroundSteeringRequest = [&gsr, &gsrMutex](cluon::data::Envelope &&env)
         {
-            steeringAngle = -0.17;
-        }
-        else if (steeringAngle <= -0.07)
+            // The envelope data structure provide further details, such as sampleTimePoint as shown in this test case:
+            // https://github.com/chrberger/libcluon/blob/master/libcluon/testsuites/TestEnvelopeConverter.cpp#L31-L40
+            std::lock_guard<std::mutex> lck(gsrMutex);
+            gsr = cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(std::move(env));
+            // std::cout << "lambda: groundSteering = " << gsr.groundSteering() << std::endl;
+        };
+
+        // Angular velocity reading handler; the yaw rate is published through a seqlock so that
+        // neither this receive thread nor the vision loop ever waits for the other.
+        // The derivative is taken over the sample time stamps of the envelopes.
+        YawRateCell yawRate{YawRateState{0.0, 0.0, 0}};
+        YawRateEstimator yawRateEstimator{yawRateFilter};
+        auto onAngularvelocityReading = [&yawRate, &yawRateEstimator](cluon::data::Envelope &&env)
         {
-            steeringAngle = -0.11;
-        }
-    }
-    return steeringAngle;
-}
-
-auto checkSteering(bool leftCone, bool rightCone, double steeringAngle, double angularVeloZ, double angularVeloZDerivative)
-{ // Function to call the steeringAlgorithm with the correct input
-    double steering = 0;
-    if (leftCone && rightCone) // Both cones detected
-    {
-        steering = steeringAlgorithm(1, steeringAngle, angularVeloZ, angularVeloZDerivative);
-    }
-    else if (!leftCone && rightCone) // Only right cone detected
-    {
-        steering = steeringAlgorithm(0, steeringAngle, angularVeloZ, angularVeloZDerivative);
-    }
-    else if (!rightCone && leftCone) // Only left cone detected
-    {
-        steering = steeringAlgorithm(2, steeringAngle, angularVeloZ, angularVeloZDerivative);
-    }
-    return steering;
-}
-
-int32_t main(int32_t argc, char **argv)
-{
-
-    int32_t retCode{1};
-
-    double angularVeloZ = 0.0;
-    double steeringAngle = 0;
-    double angularVeloZDerivative = 0.0;
-    
-    /*
-    int totalComparisons = 0;
-    int successfulComparisons = 0;
-    double tolerance = 0.25;
-    */
+            if (env.senderStamp() == 0)
+            {
+                const int64_t sampleTimeStamp{cluon::time::toMicroseconds(env.sampleTimeStamp())};
+                opendlv::proxy::AngularVelocityReading angularVZ = cluon::extractMessage<opendlv::proxy::AngularVelocityReading>(std::move(env));
+                yawRate.store(yawRateEstimator.update(angularVZ.angularVelocityZ(), sampleTimeStamp)); // Calculate derivative
+            }
+            // std::cout << "AVZ = " << angularVZ.angularVelocityZ() << "," << std::endl;
+        };
 
-    // Parse the command line parameters as we require the user to specify some mandatory information on startup.
-    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
-    if ((0 == commandlineArguments.count("cid")) ||
-        (0 == commandlineArguments.count("name")) ||
-        (0 == commandlineArguments.count("width")) ||
-        (0 == commandlineArguments.count("height")))
-    {
-        std::cerr << argv[0] << " attaches to a shared memory area containing an ARGB image." << std::endl;
-        std::cerr << "Usage:   " << argv[0] << " --cid=<OD4 session> --name=<name of shared memory area> [--verbose]" << std::endl;
-        std::cerr << "         --cid:    CID of the OD4Session to send and receive messages" << std::endl;
-        std::cerr << "         --name:   name of the shared memory area to attach" << std::endl;
-        std::cerr << "         --width:  width of the frame" << std::endl;
-        std::cerr << "         --height: height of the frame" << std::endl;
-        std::cerr << "Example: " << argv[0] << " --cid=253 --name=img --width=640 --height=480 --verbose" << std::endl;
-    }
-    else
-    {
-        // Extract the values from the command line parameters
-        const std::string NAME{commandlineArguments["name"]};
-        const uint32_t WIDTH{static_cast<uint32_t>(std::stoi(commandlineArguments["width"]))};
-        const uint32_t HEIGHT{static_cast<uint32_t>(std::stoi(commandlineArguments["height"]))};
-        const bool VERBOSE{commandlineArguments.count("verbose") != 0};
+        // The same handlers for a running session, where envelopes are decoded in place from the received datagrams.
+        auto onGroundSteeringRequestView = [&gsr, &gsrMutex](const cluon::EnvelopeView &view)
+        {
+            std::lock_guard<std::mutex> lck(gsrMutex);
+            gsr = cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(view);
+        };
+        auto onAngularvelocityReadingView = [&yawRate, &yawRateEstimator](const cluon::EnvelopeView &view)
+        {
+            if (view.senderStamp == 0)
+            {
+                const opendlv::proxy::AngularVelocityReading angularVZ{cluon::extractMessage<opendlv::proxy::AngularVelocityReading>(view)};
+                yawRate.store(yawRateEstimator.update(angularVZ.angularVelocityZ(), view.sampleTimeStampInMicroseconds()));
+            }
+        };
 
-        // Attach to the shared memory.
-        std::unique_ptr<cluon::SharedMemory> sharedMemory{new cluon::SharedMemory{NAME}};
-        if (sharedMemory && sharedMemory->valid())
+        const RegionOfInterest roi{clipRegionOfInterest(CONE_REGION_OF_INTEREST, WIDTH, HEIGHT)};
+        std::unique_ptr<ConeColourClassifier> classifier;
+        if (USE_LUT)
         {
-            std::clog << argv[0] << ": Attached to shared memory '" << sharedMemory->name() << " (" << sharedMemory->size() << " bytes)." << std::endl;
+            classifier.reset(new ConeColourClassifier{LUT_BITS, thresholds});
+            std::clog << argv[0] << ": Using a " << classifier->tableSize() << " bytes colour lookup table." << std::endl;
+        }
 
-            // Interface to a running OpenDaVINCI session where network messages are exchanged.
-            // The instance od4 allows you to send and receive messages.
-            cluon::OD4Session od4{static_cast<uint16_t>(std::stoi(commandlineArguments["cid"]))};
+        // With --bands, every frame is split into horizontal bands processed by a pool of worker threads.
+        ThreadPool pool{BANDS - 1};
+        std::unique_ptr<BandedPerception> banded;
+        if (1 < BANDS)
+        {
+            banded.reset(new BandedPerception{pool, BANDS, FrameWorkspace::maskRegionFor(WIDTH, HEIGHT, roi)});
+            std::clog << argv[0] << ": Processing frames in " << banded->bands() << " bands." << std::endl;
+        }
 
-            opendlv::proxy::GroundSteeringRequest gsr;
-            std::mutex gsrMutex;
-            auto onGroundSteeringRequest = [&gsr, &gsrMutex](cluon::data::Envelope &&env)
+        // Segmentation of the region of interest; with --verbose the frame is kept for display.
+        auto segment = [&roi, &thresholds, &classifier, &banded, VERBOSE](const cv::Mat &frame, FrameWorkspace &w)
+        {
+            // The fused kernel converts only the region of interest to HSV and thresholds both cone colours
+            // in the same pass; outside of it the masks stay empty, just as with the four filled black boxes used before.
+            if (banded)
             {
-                // The envelope data structure provide further details, such as sampleTimePoint as shown in this test case:
-                // https://github.com/chrberger/libcluon/blob/master/libcluon/testsuites/TestEnvelopeConverter.cpp#L31-L40
-                std::lock_guard<std::mutex> lck(gsrMutex);
-                gsr = cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(std::move(env));
-                // std::cout << "lambda: groundSteering = " << gsr.groundSteering() << std::endl;
-            };
-
-            od4.dataTrigger(opendlv::proxy::GroundSteeringRequest::ID(), onGroundSteeringRequest);
-
-            // Angular velocity reading handler
-            opendlv::proxy::AngularVelocityReading angularVZ;
-            std::mutex angularVZMutex;
-            auto onAngularvelocityReading = [&angularVZ, &angularVZMutex, &angularVeloZ, &angularVeloZDerivative](cluon::data::Envelope &&env)
+                banded->segment(frame, roi, thresholds, classifier.get(), w);
+            }
+            else
             {
-                std::lock_guard<std::mutex> lck(angularVZMutex);
-                angularVZ = cluon::extractMessage<opendlv::proxy::AngularVelocityReading>(std::move(env));
-                if (env.senderStamp() == 0)
-                {
-                    angularVeloZDerivative = angularVZ.angularVelocityZ() - angularVeloZ; // Calculate derivative
-                    angularVeloZ = angularVZ.angularVelocityZ();                          // Update angular velocity
-                }
-                // std::cout << "AVZ = " << angularVZ.angularVelocityZ() << "," << std::endl;
-            };
-
-            od4.dataTrigger(opendlv::proxy::AngularVelocityReading::ID(), onAngularvelocityReading);
-
-            // Endless loop; end the program by pressing Ctrl-C.
-            while (od4.isRunning())
+                segmentCones(frame, roi, thresholds, classifier.get(), w);
+            }
+            if (VERBOSE)
             {
-                // OpenCV data structure to hold an image.
-                cv::Mat img;
+                frame.copyTo(w.img);
+            }
+        };
 
-                // Wait for a notification of a new frame.
-                sharedMemory->wait();
+        // Morphology and blob extraction on the cone masks.
+        auto findBlobs = [&banded](FrameWorkspace &w)
+        {
+            if (banded)
+            {
+                banded->findBlobs(w);
+            }
+            else
+            {
+                findConeBlobs(w);
+            }
+        };
 
-                // Lock the shared memory.
-                sharedMemory->lock();
+        // Steering, output and display for a frame whose blobs have been found.
+        auto steer = [&](FrameWorkspace &w, const FrameInfo &info)
+        {
+            // Draw the bounding rectangles of the blobs onto the displayed image
+            if (VERBOSE)
+            {
+                for (const auto &blob : w.blueBlobs)
                 {
-                    // Copy the pixels from the shared memory into our own data structure.
-                    cv::Mat wrapped(HEIGHT, WIDTH, CV_8UC4, sharedMemory->data());
-                    img = wrapped.clone();
+                    cv::rectangle(w.img, cv::Rect(blob.left, blob.top, blob.right - blob.left + 1, blob.bottom - blob.top + 1), cv::Scalar(0, 255, 0), 2);
                 }
-
-                std::pair<bool, cluon::data::TimeStamp> pair = sharedMemory->getTimeStamp();
-                cluon::data::TimeStamp sampleT = pair.second;
-                int64_t sampleTimeStamp = cluon::time::toMicroseconds(sampleT);
-                // TODO: Here, you can add some code to check the sampleTimePoint when the current frame was captured.
-                sharedMemory->unlock();
-
-                cv::rectangle(img, cv::Point(0, 0), cv::Point(650, 250), cv::Scalar(0, 0, 0), cv::FILLED);
-                // Placing a black box in the region above the cones to avoid Detecting colours in the background
-                cv::rectangle(img, cv::Point(0, 375), cv::Point(650, 500), cv::Scalar(0, 0, 0), cv::FILLED);
-                // Placing a black box over the wiring of the car, in order to avoid Detecting colours there
-
-                // Left side black box, extending vertically to cover from the top to the bottom of the existing black boxes
-                cv::rectangle(img, cv::Point(0, 0), cv::Point(100, 500), cv::Scalar(0, 0, 0), cv::FILLED);
-
-                // Right side black box, similar to the left, ensuring it covers the same vertical height
-                cv::rectangle(img, cv::Point(550, 0), cv::Point(650, 500), cv::Scalar(0, 0, 0), cv::FILLED);
-
-                cv::Mat img_hsv;
-                cv::cvtColor(img, img_hsv, cv::COLOR_BGR2HSV);
-
-                // update masking values using further data derived through experimentation with colour-space images
-                cv::Scalar blue_lower_boundary = cv::Scalar(78, 50, 50);
-                cv::Scalar blue_upper_boundary = cv::Scalar(134, 255, 255);
-                // HSV values for the yellow cones
-                cv::Scalar yellow_lower_boundary = cv::Scalar(9, 0, 147);
-                cv::Scalar yellow_upper_boundary = cv::Scalar(76, 255, 255);
-
-                cv::Mat blue_masking;
-                cv::Mat yellow_masking;
-
-                // remove noise and merge individual smaller boxes together within bigger cone box
-                cv::Mat mergeBox = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(5, 5));
-                cv::Mat closeBox = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(9, 9));
-
-                cv::inRange(img_hsv, yellow_lower_boundary, yellow_upper_boundary, yellow_masking);
-                cv::inRange(img_hsv, blue_lower_boundary, blue_upper_boundary, blue_masking);
-
-                // Used for removing smaller noises and merging larger detected objects 
-                cv::morphologyEx(blue_masking, blue_masking, cv::MORPH_OPEN, mergeBox);
-                cv::morphologyEx(yellow_masking, yellow_masking, cv::MORPH_OPEN, mergeBox);
-                cv::morphologyEx(blue_masking, blue_masking, cv::MORPH_CLOSE, closeBox);
-                cv::morphologyEx(yellow_masking, yellow_masking, cv::MORPH_CLOSE, closeBox);
-
-                std::vector<std::vector<cv::Point>> blue_contours;
-                std::vector<std::vector<cv::Point>> yellow_contours;
-
-                //Finding countours of blue and yellow
-                cv::findContours(yellow_masking.clone(), yellow_contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
-                cv::findContours(blue_masking.clone(), blue_contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
-
-                // Dividing the ROI into two halves
-                cv::Rect leftRegion(0, 0, 325, 500);
-                cv::Rect rightRegion(325, 0, 325, 500);
-
-                int leftSideValue = -1;
-                int rightSideValue = -1;
-
-                // Detected cone values
-                bool blueDetectedLeft = false;
-                bool blueDetectedRight = false;
-                bool yellowDetectedLeft = false;
-                bool yellowDetectedRight = false;
-                bool leftCone = true;
-                bool rightCone = true;
-                
-
-                for (const auto &blueContour : blue_contours)
+                for (const auto &blob : w.yellowBlobs)
                 {
-                    // Calculate the bounding rectangle of the contour
-                    cv::Rect temp_blue_boundary = cv::boundingRect(blueContour);
-                    cv::rectangle(img, temp_blue_boundary, cv::Scalar(0, 255, 0), 2);
-
-                    cv::Moments blueMoments = cv::moments(blueContour);
-                    cv::Point blueCentroid(static_cast<int>(blueMoments.m10 / blueMoments.m00), static_cast<int>(blueMoments.m01 / blueMoments.m00));
-                    // Check if the centroid is in the left region and cones are not detected on the right side
-                    if (leftRegion.contains(blueCentroid) && !blueDetectedRight)
-                    {
-                        leftSideValue = 0; // Blue cones on the left side
-                        blueDetectedLeft = true;
-                    }
-                    else if (rightRegion.contains(blueCentroid) && !blueDetectedLeft)
-                    {
-                        rightSideValue = 0; // Blue cones on the right side
-                        blueDetectedRight = true;
-                    }
+                    cv::rectangle(w.img, cv::Rect(blob.left, blob.top, blob.right - blob.left + 1, blob.bottom - blob.top + 1), cv::Scalar(0, 200, 0), 2);
                 }
+            }
 
-                for (const auto &yellowContour : yellow_contours)
-                {
-                    // Calculate the bounding rectangle of the contour
-                    cv::Rect temp_yellow_boundary = cv::boundingRect(yellowContour);
-                    cv::rectangle(img, temp_yellow_boundary, cv::Scalar(0, 200, 0), 2);
+            // Sorting the blobs into the left and right half of the frame and calling checkSteering with the right input
+            steeringAngle = steerFromBlobs(w, yawRate.load(), steeringParameters);
 
-                    cv::Moments yellowMoments = cv::moments(yellowContour); 
-                    cv::Point yellowCentroid(static_cast<int>(yellowMoments.m10 / yellowMoments.m00), static_cast<int>(yellowMoments.m01 / yellowMoments.m00));
+            // TODO: Do something with the frame.
+            // Example: Draw a red rectangle and display image.
+            // cv::rectangle(img, cv::Point(50, 50), cv::Point(100, 100), cv::Scalar(0,0,255));
 
-                    // Check if the centroid is in the left region and cones are not detected on the right side
-                    if (leftRegion.contains(yellowCentroid) && !yellowDetectedRight)
-                    {
-                        leftSideValue = 1; // Yellow cones on the left side
-                        yellowDetectedLeft = true;
-                    }
-                    else if (rightRegion.contains(yellowCentroid) && !yellowDetectedLeft)
-                    {
-                        rightSideValue = 1; // Yellow cones on the right side
-                        yellowDetectedRight = true;
-                    }
-                }
+            // If you want to access the latest received ground steering, don't forget to lock the mutex:
+            {
+                //std::cout << "main: groundSteering: " << gsr.groundSteering() << std::endl;
+                //std::cout << "our: " << steeringAngle << std::endl;
+                std::cout << "Group_15;" << info.sampleTimeStamp << ";" << steeringAngle << std::endl;
+            }
 
-                if (!blueDetectedLeft && !yellowDetectedLeft)
-                {
-                    leftCone = false; // Make the left cone false if no cones are detected on that side
-                }
+            // Display image on your screen.
+            if (VERBOSE)
+            {
+                AllocationCounter::Pause pause;
+                std::clog << argv[0] << ": Shared memory locked for " << info.lockHoldMicroseconds << " us." << std::endl;
+                cv::imshow(WINDOW.c_str(), w.img);
+                cv::waitKey(1);
+            }
+        };
 
-                if (!blueDetectedRight && !yellowDetectedRight)
+        if (!RECORDING.empty())
+        {
+            // Offline replay: the recording drives the same handlers and frame processing, without pacing.
+            RecordingReplay replay{RECORDING};
+            if (!replay.valid())
+            {
+                std::cerr << argv[0] << ": Cannot replay '" << RECORDING << "'." << std::endl;
+                return retCode;
+            }
+            replay.dataTrigger(opendlv::proxy::GroundSteeringRequest::ID(), onGroundSteeringRequest);
+            replay.dataTrigger(opendlv::proxy::AngularVelocityReading::ID(), onAngularvelocityReading);
+
+            FrameWorkspace ws{WIDTH, HEIGHT, roi};
+            uint64_t mismatchingFrames{0};
+            // Frames with a non-zero ground steering request and those steered within 25% of it.
+            uint64_t totalComparisons{0};
+            uint64_t successfulComparisons{0};
+            replay.frameTrigger([&](const cv::Mat &frame, int64_t sampleTimeStamp)
+            {
+                if ((static_cast<uint32_t>(frame.cols) != WIDTH) || (static_cast<uint32_t>(frame.rows) != HEIGHT))
                 {
-                    rightCone = false; // Make the right cone false if no cones are detected on that side
+                    mismatchingFrames++;
+                    return;
                 }
+                ws.beginFrame();
+                segment(frame, ws);
+                findBlobs(ws);
+                steer(ws, FrameInfo{sampleTimeStamp, 0});
+                ws.endFrame();
 
-                steeringAngle = checkSteering(leftCone, rightCone, steeringAngle, angularVeloZ, angularVeloZDerivative);
-                // Calling the checkSteering function to call the steering angle with the right input
-
-                // TODO: Do something with the frame.
-                // Example: Draw a red rectangle and display image.
-                // cv::rectangle(img, cv::Point(50, 50), cv::Point(100, 100), cv::Scalar(0,0,255));
-
-                // If you want to access the latest received ground steering, don't forget to lock the mutex:
+                std::lock_guard<std::mutex> lck(gsrMutex);
+                const double groundSteering{gsr.groundSteering()};
+                if (0.0 < std::fabs(groundSteering))
                 {
-                    /*
-                    std::lock_guard<std::mutex> lck(gsrMutex);
-                    if (groundSteering != 0)
-                    {
-                        totalComparisons++;
-                        double lowerBound = groundSteering * (1 - tolerance);
-                        double upperBound = groundSteering * (1 + tolerance);
-                        if (steeringAngle >= lowerBound && steeringAngle <= upperBound)
-                        {
-                            successfulComparisons++;
-                        }
-                    }    
-                    */
-                    //std::cout << "main: groundSteering: " << gsr.groundSteering() << std::endl;
-                    //std::cout << "our: " << steeringAngle << std::endl;
-                    std::cout << "Group_15;" << sampleTimeStamp << ";" << steeringAngle << std::endl;
+                    totalComparisons++;
+                    successfulComparisons += withinTolerance(steeringAngle, groundSteering, 0.25) ? 1 : 0;
                 }
+            });
 
-                // Display image on your screen.
-                if (VERBOSE)
-                {
-                    cv::imshow(sharedMemory->name().c_str(), img);
-                    cv::waitKey(1);
-                }
+            const ReplayStatistics statistics{replay.run()};
+            std::clog << argv[0] << ": Replayed " << statistics.frames << " frames of " << statistics.envelopes << " envelopes in " << statistics.seconds
+                      << " s (" << ((0.0 < statistics.seconds) ? statistics.frames / statistics.seconds : 0.0) << " frames/s)." << std::endl;
+            if ((0 != statistics.undecodableFrames) || (0 != mismatchingFrames))
+            {
+                std::clog << argv[0] << ": Skipped " << statistics.undecodableFrames << " undecodable frames and " << mismatchingFrames << " frames not of "
+                          << WIDTH << "x" << HEIGHT << "." << std::endl;
+            }
+            if (statistics.frames == mismatchingFrames)
+            {
+                std::cerr << argv[0] << ": No frame of '" << RECORDING << "' could be decoded at " << WIDTH << "x" << HEIGHT << "." << std::endl;
+                return retCode;
             }
-            
-            /*
             if (totalComparisons > 0)
             {
                 double accuracy = (static_cast<double>(successfulComparisons) / totalComparisons) * 100.0;
-                std::cout << "Accuracy of steering algorithm: " << accuracy << "%" << std::endl;
+                std::clog << "Accuracy of steering algorithm: " << accuracy << "%" << std::endl;
             }
             else
             {
-                std::cout << "No valid comparisons made." << std::endl;
+                std::clog << "No valid comparisons made." << std::endl;
+            }
+        }
+        else
+        {
+            // Attach to the shared memory.
+            std::unique_ptr<cluon::SharedMemory> sharedMemory{new cluon::SharedMemory{NAME}};
+            if (sharedMemory && sharedMemory->valid())
+            {
+                std::clog << argv[0] << ": Attached to shared memory '" << sharedMemory->name() << " (" << sharedMemory->size() << " bytes)." << std::endl;
+
+                // Interface to a running OpenDaVINCI session where network messages are exchanged.
+                // The instance od4 allows you to send and receive messages.
+                cluon::OD4Session od4{static_cast<uint16_t>(std::stoi(commandlineArguments["cid"]))};
+
+                od4.dataViewTrigger(opendlv::proxy::GroundSteeringRequest::ID(), onGroundSteeringRequestView);
+                od4.dataViewTrigger(opendlv::proxy::AngularVelocityReading::ID(), onAngularvelocityReadingView);
+
+                FrameAcquisition acquisition{*sharedMemory, WIDTH, HEIGHT, acquisitionMode};
+
+                if (PIPELINE)
+                {
+                    // Frame N + 1 is acquired and segmented while frame N is in the morphology; stale frames are dropped.
+                    VisionPipeline pipeline{acquisition, WIDTH, HEIGHT, segment, findBlobs, steer, CORES, std::chrono::seconds(5)};
+                    pipeline.run([&od4]() { return od4.isRunning(); });
+                }
+                else
+                {
+                    // Buffers reused for every frame.
+                    FrameWorkspace ws{WIDTH, HEIGHT, roi};
+
+                    // Endless loop; end the program by pressing Ctrl-C.
+                    while (od4.isRunning())
+                    {
+                        ws.beginFrame();
+
+                        // Wait for a new frame; depending on the acquisition mode the shared memory is still locked.
+                        const cv::Mat &frame = acquisition.acquire();
+                        const int64_t sampleTimeStamp{acquisition.sampleTimeStamp()};
+                        segment(frame, ws);
+                        acquisition.release();
+
+                        findBlobs(ws);
+                        steer(ws, FrameInfo{sampleTimeStamp, acquisition.lockHoldMicroseconds()});
+                        ws.endFrame();
+                    }
+                }
             }
-            
-            */
         }
         retCode = 0;
     }
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "thread-affinity.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+bool parseCoreList(const std::string &list, std::vector<int32_t> &cores)
+{
+    cores.clear();
+    std::stringstream sstr{list};
+    std::string entry;
+    while (std::getline(sstr, entry, ','))
+    {
+        if (entry.empty() || (std::string::npos != entry.find_first_not_of("0123456789")))
+        {
+            return false;
+        }
+        try
+        {
+            cores.push_back(static_cast<int32_t>(std::stoi(entry)));
+        }
+        catch (const std::exception &)
+        {
+            // The entry holds digits only, so this is a number beyond int.
+            return false;
+        }
+    }
+    return !cores.empty();
+}
+
+bool pinCurrentThread(int32_t core) noexcept
+{
+    if (0 > core)
+    {
+        return true;
+    }
+#if defined(__linux__)
+    if (CPU_SETSIZE <= core)
+    {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<size_t>(core), &set);
+    return 0 == ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+#else
+    return false;
+#endif
+}
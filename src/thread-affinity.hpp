@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREAD_AFFINITY_HPP
+#define THREAD_AFFINITY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Parse a comma separated list of CPU core numbers such as "1,2,3"; returns false
+// if an entry is not a non-negative number.
+bool parseCoreList(const std::string &list, std::vector<int32_t> &cores);
+
+// Pin the calling thread to one core; returns false if that is not possible on
+// this platform or the core does not exist. A negative core leaves the thread alone.
+bool pinCurrentThread(int32_t core) noexcept;
+
+#endif
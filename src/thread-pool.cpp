@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "thread-pool.hpp"
+
+ThreadPool::ThreadPool(uint32_t workers)
+{
+    for (uint32_t i{0}; i < workers; i++)
+    {
+        m_threads.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+uint32_t ThreadPool::workers() const noexcept
+{
+    return static_cast<uint32_t>(m_threads.size());
+}
+
+void ThreadPool::runTasks(uint32_t tasks, TaskFunction function, void *context)
+{
+    std::lock_guard<std::mutex> turn(m_runMutex);
+    if (m_threads.empty() || (1 >= tasks))
+    {
+        for (uint32_t i{0}; i < tasks; i++)
+        {
+            function(context, i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lck(m_mutex);
+        m_function = function;
+        m_context = context;
+        m_tasks = tasks;
+        m_next.store(0, std::memory_order_relaxed);
+        m_busy = static_cast<uint32_t>(m_threads.size());
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lck(m_mutex);
+    m_done.wait(lck, [this]() { return 0 == m_busy; });
+}
+
+void ThreadPool::work()
+{
+    uint64_t generation{0};
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lck(m_mutex);
+            m_wake.wait(lck, [this, &generation]() { return m_stop || (generation != m_generation); });
+            if (m_stop)
+            {
+                return;
+            }
+            generation = m_generation;
+        }
+
+        drain();
+
+        bool last{false};
+        {
+            std::lock_guard<std::mutex> lck(m_mutex);
+            last = (0 == --m_busy);
+        }
+        if (last)
+        {
+            m_done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::drain() noexcept
+{
+    // Tasks are handed out one at a time, so faster threads simply take more of them.
+    uint32_t task{m_next.fetch_add(1, std::memory_order_relaxed)};
+    while (task < m_tasks)
+    {
+        m_function(m_context, task);
+        task = m_next.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Persistent worker threads for splitting one frame into parallel tasks. The
+// thread calling run() works on the tasks as well, so a pool with n workers runs
+// up to n + 1 tasks at once; a pool without workers runs everything inline.
+// Dispatching does not allocate: the task is passed as a plain function pointer
+// and a context pointer to the caller's callable.
+class ThreadPool
+{
+  private:
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool(ThreadPool &&) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ThreadPool &operator=(ThreadPool &&) = delete;
+
+  public:
+    explicit ThreadPool(uint32_t workers);
+    ~ThreadPool();
+
+    uint32_t workers() const noexcept;
+
+    // Call task(i) for every i in [0, tasks) and return when all calls are done.
+    // Concurrent calls from different threads take turns.
+    template <typename Task>
+    void run(uint32_t tasks, Task &&task)
+    {
+        runTasks(tasks, &invoke<typename std::remove_reference<Task>::type>, &task);
+    }
+
+  private:
+    using TaskFunction = void (*)(void *context, uint32_t task);
+
+    template <typename Task>
+    static void invoke(void *context, uint32_t task)
+    {
+        (*static_cast<Task *>(context))(task);
+    }
+
+    void runTasks(uint32_t tasks, TaskFunction function, void *context);
+    void work();
+    void drain() noexcept;
+
+  private:
+    std::mutex m_runMutex{};
+    std::mutex m_mutex{};
+    std::condition_variable m_wake{};
+    std::condition_variable m_done{};
+    uint64_t m_generation{0};
+    uint32_t m_busy{0};
+    bool m_stop{false};
+
+    TaskFunction m_function{nullptr};
+    void *m_context{nullptr};
+    uint32_t m_tasks{0};
+    std::atomic<uint32_t> m_next{0};
+
+    std::vector<std::thread> m_threads{};
+};
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "vision-pipeline.hpp"
+#include "allocation-counter.hpp"
+#include "thread-affinity.hpp"
+
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+// One workspace per stage plus one being filled by acquire.
+constexpr uint32_t SLOTS{4};
+
+// Spin briefly, then yield, then sleep in short steps until an item arrives or
+// keepWaiting() turns false. Frames arrive every few tens of milliseconds, so the
+// sleeps add little latency while an idle stage gives its core back.
+template <typename T, typename KeepWaiting>
+bool popWaiting(SpscQueue<T> &queue, T &item, KeepWaiting &&keepWaiting)
+{
+    uint32_t attempts{0};
+    while (!queue.pop(item))
+    {
+        if (!keepWaiting())
+        {
+            return false;
+        }
+        if (attempts < 64)
+        {
+            attempts++;
+        }
+        else if (attempts < 128)
+        {
+            attempts++;
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+    return true;
+}
+
+// Like FrameWorkspace::endFrame(): once its first frame has sized everything, a stage must not allocate.
+void assertNoAllocations(uint64_t before, uint64_t frame) noexcept
+{
+    assert((0 == frame) || (AllocationCounter::allocations() == before));
+    static_cast<void>(before);
+    static_cast<void>(frame);
+}
+
+void warnIfUnpinned(bool pinned, const char *stage, int32_t core)
+{
+    if (!pinned)
+    {
+        AllocationCounter::Pause pause;
+        std::clog << "pipeline: Could not pin the " << stage << " stage to core " << core << "." << std::endl;
+    }
+}
+
+const char *STAGE_NAMES[]{"acquire", "blobs", "output"};
+} // namespace
+
+VisionPipeline::Slot::Slot(uint32_t width, uint32_t height, const RegionOfInterest &roi)
+    : workspace{width, height, roi}
+{
+}
+
+void VisionPipeline::StageStatistics::record(std::chrono::steady_clock::duration duration) noexcept
+{
+    const uint64_t nanoseconds{static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count())};
+    frames.fetch_add(1, std::memory_order_relaxed);
+    totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    if (nanoseconds > maximumNanoseconds.load(std::memory_order_relaxed))
+    {
+        maximumNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+VisionPipeline::VisionPipeline(FrameAcquisition &acquisition, uint32_t width, uint32_t height, Segmenter segmenter, BlobFinder blobFinder, Consumer consumer,
+                               std::vector<int32_t> cores, std::chrono::milliseconds reportInterval)
+    : m_acquisition{acquisition}
+    , m_segmenter{std::move(segmenter)}
+    , m_blobFinder{std::move(blobFinder)}
+    , m_consumer{std::move(consumer)}
+    , m_cores{std::move(cores)}
+    , m_reportInterval{reportInterval}
+    , m_free{SLOTS}
+    , m_segmented{SLOTS}
+    , m_extracted{SLOTS}
+    , m_statistics{}
+{
+    for (uint32_t i{0}; i < SLOTS; i++)
+    {
+        m_slots.emplace_back(new Slot{width, height, acquisition.regionOfInterest()});
+        // Let the morphology size its scratch rows before the first real frame.
+        m_blobFinder(m_slots.back()->workspace);
+        m_free.push(m_slots.back().get());
+    }
+}
+
+int32_t VisionPipeline::coreFor(Stage stage) const noexcept
+{
+    return (stage < m_cores.size()) ? m_cores[stage] : -1;
+}
+
+void VisionPipeline::run(const std::function<bool()> &running)
+{
+    m_stop.store(false, std::memory_order_release);
+    std::atomic<bool> acquireDone{false};
+    std::thread acquire{[this, &acquireDone]() {
+        acquireStage();
+        acquireDone.store(true, std::memory_order_release);
+    }};
+    std::thread blobs{&VisionPipeline::blobStage, this};
+
+    warnIfUnpinned(pinCurrentThread(coreFor(OUTPUT)), STAGE_NAMES[OUTPUT], coreFor(OUTPUT));
+    outputStage(running);
+
+    // acquire may be blocked waiting for the next frame; keep waking it up until it noticed.
+    m_stop.store(true, std::memory_order_release);
+    while (!acquireDone.load(std::memory_order_acquire))
+    {
+        m_acquisition.interrupt();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    acquire.join();
+    blobs.join();
+
+    // Hand every workspace back so that the pipeline can be run again.
+    Slot *slot{nullptr};
+    while (m_segmented.pop(slot) || m_extracted.pop(slot))
+    {
+        m_free.push(slot);
+    }
+}
+
+void VisionPipeline::acquireStage()
+{
+    warnIfUnpinned(pinCurrentThread(coreFor(ACQUIRE)), STAGE_NAMES[ACQUIRE], coreFor(ACQUIRE));
+    StageStatistics &statistics{m_statistics[ACQUIRE]};
+    uint64_t frames{0};
+    while (!m_stop.load(std::memory_order_acquire))
+    {
+        const cv::Mat &frame = m_acquisition.acquire();
+        const auto acquiredAt{std::chrono::steady_clock::now()};
+        const uint64_t allocations{AllocationCounter::allocations()};
+
+        Slot *slot{nullptr};
+        if (m_stop.load(std::memory_order_acquire) || !m_free.pop(slot))
+        {
+            // Every workspace is still busy downstream; dropping the frame here keeps the latency bounded.
+            m_acquisition.release();
+            statistics.dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        m_segmenter(frame, slot->workspace);
+        slot->info.sampleTimeStamp = m_acquisition.sampleTimeStamp();
+        m_acquisition.release();
+        slot->info.lockHoldMicroseconds = m_acquisition.lockHoldMicroseconds();
+        slot->acquiredAt = acquiredAt;
+        slot->stale = false;
+        m_segmented.push(slot);
+
+        statistics.record(std::chrono::steady_clock::now() - acquiredAt);
+        assertNoAllocations(allocations, frames++);
+    }
+}
+
+void VisionPipeline::blobStage()
+{
+    warnIfUnpinned(pinCurrentThread(coreFor(BLOBS)), STAGE_NAMES[BLOBS], coreFor(BLOBS));
+    StageStatistics &statistics{m_statistics[BLOBS]};
+    uint64_t frames{0};
+    Slot *slot{nullptr};
+    auto keepRunning = [this]() { return !m_stop.load(std::memory_order_acquire); };
+    while (keepRunning() && popWaiting(m_segmented, slot, keepRunning))
+    {
+        // Skip to the newest segmented frame; older ones travel on marked stale for the output stage to recycle.
+        Slot *newer{nullptr};
+        while (m_segmented.pop(newer))
+        {
+            slot->stale = true;
+            m_extracted.push(slot);
+            statistics.dropped.fetch_add(1, std::memory_order_relaxed);
+            slot = newer;
+        }
+
+        const auto begin{std::chrono::steady_clock::now()};
+        const uint64_t allocations{AllocationCounter::allocations()};
+        m_blobFinder(slot->workspace);
+        m_extracted.push(slot);
+
+        statistics.record(std::chrono::steady_clock::now() - begin);
+        assertNoAllocations(allocations, frames++);
+    }
+}
+
+void VisionPipeline::outputStage(const std::function<bool()> &running)
+{
+    StageStatistics &statistics{m_statistics[OUTPUT]};
+    uint64_t frames{0};
+    auto lastReport{std::chrono::steady_clock::now()};
+    Slot *slot{nullptr};
+    while (running() && popWaiting(m_extracted, slot, running))
+    {
+        // Skip to the newest frame with blobs; everything older only goes back to acquire.
+        Slot *newer{nullptr};
+        while (m_extracted.pop(newer))
+        {
+            if (newer->stale)
+            {
+                m_free.push(newer);
+                continue;
+            }
+            if (!slot->stale)
+            {
+                statistics.dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            m_free.push(slot);
+            slot = newer;
+        }
+        if (slot->stale)
+        {
+            m_free.push(slot);
+            continue;
+        }
+
+        const auto begin{std::chrono::steady_clock::now()};
+        const uint64_t allocations{AllocationCounter::allocations()};
+        m_consumer(slot->workspace, slot->info);
+        const auto end{std::chrono::steady_clock::now()};
+        m_free.push(slot);
+
+        statistics.record(end - begin);
+        m_endToEnd.record(end - slot->acquiredAt);
+        assertNoAllocations(allocations, frames++);
+
+        if ((0 < m_reportInterval.count()) && (end - lastReport >= m_reportInterval))
+        {
+            report(end - lastReport);
+            lastReport = end;
+        }
+    }
+}
+
+void VisionPipeline::report(std::chrono::steady_clock::duration elapsed)
+{
+    AllocationCounter::Pause pause;
+    const double seconds{std::chrono::duration<double>(elapsed).count()};
+    auto print = [seconds](const char *name, StageStatistics &statistics) {
+        const uint64_t frames{statistics.frames.exchange(0, std::memory_order_relaxed)};
+        const uint64_t dropped{statistics.dropped.exchange(0, std::memory_order_relaxed)};
+        const uint64_t total{statistics.totalNanoseconds.exchange(0, std::memory_order_relaxed)};
+        const uint64_t maximum{statistics.maximumNanoseconds.exchange(0, std::memory_order_relaxed)};
+        const double mean{(0 < frames) ? static_cast<double>(total) / static_cast<double>(frames) : 0.0};
+        std::clog << "pipeline: " << std::left << std::setw(11) << name << std::right << std::fixed << std::setprecision(1) << std::setw(6)
+                  << static_cast<double>(frames) / seconds << " fps, " << std::setprecision(3) << mean / 1e6 << " ms mean, " << static_cast<double>(maximum) / 1e6
+                  << " ms max, " << dropped << " dropped" << std::defaultfloat << std::endl;
+    };
+    for (uint32_t stage{0}; stage < STAGES; stage++)
+    {
+        print(STAGE_NAMES[stage], m_statistics[stage]);
+    }
+    print("end-to-end", m_endToEnd);
+}
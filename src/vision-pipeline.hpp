@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VISION_PIPELINE_HPP
+#define VISION_PIPELINE_HPP
+
+#include "frame-acquisition.hpp"
+#include "frame-workspace.hpp"
+#include "spsc-queue.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// What the last stage gets to know about the frame besides the workspace.
+struct FrameInfo
+{
+    int64_t sampleTimeStamp;
+    int64_t lockHoldMicroseconds;
+};
+
+// Runs the vision loop as three stages on their own threads, connected by lock-free
+// single-producer/single-consumer queues:
+//
+//   acquire  - wait for the shared memory, segment the region of interest, release;
+//   blobs    - morphology and blob extraction;
+//   output   - the consumer (steering, output and display), on the thread calling run().
+//
+// Frames travel in a fixed set of workspaces that circulate through the stages and
+// back, so frame N + 1 is segmented while frame N is in the morphology. Latency is
+// bounded by dropping instead of queueing: acquire drops a frame if no workspace is
+// free, and blobs and output skip to the newest frame waiting for them.
+class VisionPipeline
+{
+  private:
+    VisionPipeline(const VisionPipeline &) = delete;
+    VisionPipeline(VisionPipeline &&) = delete;
+    VisionPipeline &operator=(const VisionPipeline &) = delete;
+    VisionPipeline &operator=(VisionPipeline &&) = delete;
+
+  public:
+    using Segmenter = std::function<void(const cv::Mat &frame, FrameWorkspace &ws)>;
+    using BlobFinder = std::function<void(FrameWorkspace &ws)>;
+    using Consumer = std::function<void(FrameWorkspace &ws, const FrameInfo &info)>;
+
+    // cores lists the core for the acquire, blobs and output stage in that order;
+    // missing or negative entries leave a stage unpinned. A zero reportInterval
+    // disables the statistics printed to std::clog.
+    VisionPipeline(FrameAcquisition &acquisition, uint32_t width, uint32_t height, Segmenter segmenter, BlobFinder blobFinder, Consumer consumer,
+                   std::vector<int32_t> cores, std::chrono::milliseconds reportInterval);
+
+    // Run until running() returns false; the output stage runs on the calling thread.
+    void run(const std::function<bool()> &running);
+
+  private:
+    struct Slot
+    {
+        Slot(uint32_t width, uint32_t height, const RegionOfInterest &roi);
+
+        FrameWorkspace workspace;
+        FrameInfo info{0, 0};
+        std::chrono::steady_clock::time_point acquiredAt{};
+        bool stale{false};
+    };
+
+    // Written by one stage thread, read and reset by the report.
+    struct StageStatistics
+    {
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> totalNanoseconds{0};
+        std::atomic<uint64_t> maximumNanoseconds{0};
+
+        void record(std::chrono::steady_clock::duration duration) noexcept;
+    };
+
+    enum Stage : uint32_t
+    {
+        ACQUIRE = 0,
+        BLOBS = 1,
+        OUTPUT = 2,
+        STAGES = 3
+    };
+
+    void acquireStage();
+    void blobStage();
+    void outputStage(const std::function<bool()> &running);
+    void report(std::chrono::steady_clock::duration elapsed);
+    int32_t coreFor(Stage stage) const noexcept;
+
+  private:
+    FrameAcquisition &m_acquisition;
+    Segmenter m_segmenter;
+    BlobFinder m_blobFinder;
+    Consumer m_consumer;
+    const std::vector<int32_t> m_cores;
+    const std::chrono::milliseconds m_reportInterval;
+
+    std::vector<std::unique_ptr<Slot>> m_slots{};
+    SpscQueue<Slot *> m_free;
+    SpscQueue<Slot *> m_segmented;
+    SpscQueue<Slot *> m_extracted;
+    std::atomic<bool> m_stop{false};
+
+    StageStatistics m_statistics[STAGES];
+    StageStatistics m_endToEnd{};
+};
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "yaw-rate-estimator.hpp"
+
+#include <algorithm>
+
+namespace
+{
+constexpr double PI{3.14159265358979323846};
+} // namespace
+
+constexpr uint32_t YawRateEstimator::MAXIMUM_WINDOW;
+
+bool parseYawRateFilter(const std::string &name, YawRateFilter &filter)
+{
+    if ("sample" == name)
+    {
+        filter = YawRateFilter::Sample;
+    }
+    else if ("difference" == name)
+    {
+        filter = YawRateFilter::Difference;
+    }
+    else if ("lowpass" == name)
+    {
+        filter = YawRateFilter::LowPass;
+    }
+    else if ("savitzky-golay" == name)
+    {
+        filter = YawRateFilter::SavitzkyGolay;
+    }
+    else if ("alpha-beta" == name)
+    {
+        filter = YawRateFilter::AlphaBeta;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+YawRateEstimator::YawRateEstimator(const YawRateFilterSettings &settings) noexcept
+    : m_settings{settings}
+{
+    m_settings.window = std::min(std::max<uint32_t>(m_settings.window, 2), MAXIMUM_WINDOW);
+}
+
+const YawRateFilterSettings &YawRateEstimator::settings() const noexcept
+{
+    return m_settings;
+}
+
+double YawRateEstimator::elapsed(int64_t sampleTimeStamp) const noexcept
+{
+    const double dt{static_cast<double>(sampleTimeStamp - m_state.sampleTimeStamp) * 1e-6};
+    return (m_first || (0.0 >= dt)) ? m_settings.nominalPeriod : dt;
+}
+
+YawRateState YawRateEstimator::update(double value, int64_t sampleTimeStamp) noexcept
+{
+    const double dt{elapsed(sampleTimeStamp)};
+    const double nominal{m_settings.nominalPeriod};
+    m_clock += dt;
+
+    switch (m_settings.filter)
+    {
+        case YawRateFilter::Sample:
+            // The previous reading starts out as 0, as it always did.
+            m_state.derivative = value - m_raw;
+            m_state.value = value;
+            break;
+        case YawRateFilter::Difference:
+            m_state.derivative = m_first ? 0.0 : (value - m_raw) / dt * nominal;
+            m_state.value = value;
+            break;
+        case YawRateFilter::LowPass:
+        {
+            const double rc{1.0 / (2.0 * PI * m_settings.cutoffFrequency)};
+            const double filtered{m_first ? value : m_state.value + (dt / (rc + dt)) * (value - m_state.value)};
+            m_state.derivative = m_first ? 0.0 : (filtered - m_state.value) / dt * nominal;
+            m_state.value = filtered;
+            break;
+        }
+        case YawRateFilter::SavitzkyGolay:
+            savitzkyGolay(value, dt);
+            break;
+        case YawRateFilter::AlphaBeta:
+            if (m_first)
+            {
+                m_state.value = value;
+                m_rate = 0.0;
+            }
+            else
+            {
+                const double predicted{m_state.value + m_rate * dt};
+                const double residual{value - predicted};
+                m_state.value = predicted + m_settings.alpha * residual;
+                m_rate += m_settings.beta * residual / dt;
+            }
+            m_state.derivative = m_rate * nominal;
+            break;
+    }
+
+    m_raw = value;
+    m_first = false;
+    m_state.sampleTimeStamp = sampleTimeStamp;
+    return m_state;
+}
+
+void YawRateEstimator::savitzkyGolay(double value, double dt) noexcept
+{
+    const double n0{static_cast<double>(m_count)};
+    // The newest reading becomes time 0, so all kept readings move dt into the past.
+    m_sumTT += -2.0 * dt * m_sumT + n0 * dt * dt;
+    m_sumTV -= dt * m_sumV;
+    m_sumT -= n0 * dt;
+
+    if (m_count == m_settings.window)
+    {
+        const Reading &oldest{m_ring[m_head]};
+        const double t{oldest.time - m_clock};
+        m_sumT -= t;
+        m_sumTT -= t * t;
+        m_sumV -= oldest.value;
+        m_sumTV -= t * oldest.value;
+        m_count--;
+    }
+    m_ring[m_head] = Reading{m_clock, value};
+    m_head = (m_head + 1) % m_settings.window;
+    m_sumV += value;
+    m_count++;
+
+    // Rounding errors of the running sums are wiped out once per turn of the ring.
+    if (0 == m_head)
+    {
+        m_sumT = m_sumTT = m_sumV = m_sumTV = 0.0;
+        for (uint32_t i{0}; i < m_count; i++)
+        {
+            const double t{m_ring[i].time - m_clock};
+            m_sumT += t;
+            m_sumTT += t * t;
+            m_sumV += m_ring[i].value;
+            m_sumTV += t * m_ring[i].value;
+        }
+    }
+
+    const double n{static_cast<double>(m_count)};
+    const double denominator{n * m_sumTT - m_sumT * m_sumT};
+    const double slope{(1 < m_count) && (0.0 < denominator) ? (n * m_sumTV - m_sumT * m_sumV) / denominator : 0.0};
+    // The fitted line evaluated at the newest reading, which sits at time 0.
+    m_state.value = (m_sumV - slope * m_sumT) / n;
+    m_state.derivative = slope * m_settings.nominalPeriod;
+}
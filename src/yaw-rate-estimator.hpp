@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef YAW_RATE_ESTIMATOR_HPP
+#define YAW_RATE_ESTIMATOR_HPP
+
+#include "yaw-rate-state.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// How the yaw rate and its derivative are estimated from the readings.
+enum class YawRateFilter
+{
+    Sample,        // Difference to the previous reading, ignoring time; the original behaviour.
+    Difference,    // Difference to the previous reading divided by the time between them.
+    LowPass,       // First-order low-pass on the yaw rate, derivative of the filtered signal.
+    SavitzkyGolay, // Least-squares line through the last window readings at their time stamps.
+    AlphaBeta      // Alpha-beta tracker of yaw rate and derivative.
+};
+
+// Parse "sample", "difference", "lowpass", "savitzky-golay" or "alpha-beta"; returns false for anything else.
+bool parseYawRateFilter(const std::string &name, YawRateFilter &filter);
+
+struct YawRateFilterSettings
+{
+    YawRateFilter filter{YawRateFilter::Sample};
+    // The steering gains were tuned on per-reading differences of the ~16 Hz yaw rate
+    // in our recordings, which Sample keeps. The other filters report derivatives per
+    // this period (in seconds), so the gains keep their meaning while the estimate no
+    // longer depends on rate and jitter.
+    double nominalPeriod{0.0614};
+    // LowPass: cut-off frequency in Hz.
+    double cutoffFrequency{4.0};
+    // SavitzkyGolay: readings in the fit, 2 to MAXIMUM_WINDOW.
+    uint32_t window{5};
+    // AlphaBeta: gains for the residual applied to yaw rate and derivative.
+    double alpha{0.5};
+    double beta{0.1};
+};
+
+// Streaming estimator fed from the OD4Session receive thread. Every reading costs
+// O(1) whatever the filter: the Savitzky-Golay fit keeps running sums over a fixed
+// ring of the last readings instead of refitting the window. Readings whose time
+// stamp does not advance are taken to be nominalPeriod apart.
+class YawRateEstimator
+{
+  public:
+    static constexpr uint32_t MAXIMUM_WINDOW{32};
+
+    explicit YawRateEstimator(const YawRateFilterSettings &settings = YawRateFilterSettings{}) noexcept;
+
+    // Feed one reading (rad/s, sample time stamp in microseconds) and return the estimate.
+    YawRateState update(double value, int64_t sampleTimeStamp) noexcept;
+
+    const YawRateFilterSettings &settings() const noexcept;
+
+  private:
+    struct Reading
+    {
+        double time; // Seconds since the first reading.
+        double value;
+    };
+
+    double elapsed(int64_t sampleTimeStamp) const noexcept;
+    void savitzkyGolay(double value, double dt) noexcept;
+
+  private:
+    YawRateFilterSettings m_settings;
+    YawRateState m_state{0.0, 0.0, 0};
+    bool m_first{true};
+    double m_raw{0.0};
+    double m_clock{0.0};
+    // AlphaBeta: tracked derivative in rad/s^2.
+    double m_rate{0.0};
+
+    // Ring of the readings in the Savitzky-Golay window and their running sums, with
+    // times relative to the newest reading.
+    std::array<Reading, MAXIMUM_WINDOW> m_ring{};
+    uint32_t m_head{0};
+    uint32_t m_count{0};
+    double m_sumT{0.0};
+    double m_sumTT{0.0};
+    double m_sumV{0.0};
+    double m_sumTV{0.0};
+};
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef YAW_RATE_STATE_HPP
+#define YAW_RATE_STATE_HPP
+
+#include "seqlock.hpp"
+
+#include <cstdint>
+
+// Latest yaw rate (AngularVelocityReading.angularVelocityZ) as seen by the vision loop.
+struct YawRateState
+{
+    double value;
+    double derivative;
+    int64_t sampleTimeStamp; // Microseconds; 0 until the first reading arrived.
+};
+
+// Written by the OD4Session receive thread, read by the vision thread(s).
+using YawRateCell = SeqLock<YawRateState>;
+
+#endif
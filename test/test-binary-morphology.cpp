@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Regression test for the bit-packed morphology: erode(), dilate(), open() and
+// close() of PackedMasks, and the open/close sequence of the vision loop, must
+// match cv::morphologyEx with a rectangle on random masks of random sizes.
+
+#include "binary-morphology.hpp"
+#include "frame-workspace.hpp"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+namespace
+{
+enum class Operation
+{
+    ERODE,
+    DILATE,
+    OPEN,
+    CLOSE,
+    // open(MERGE_RADIUS) followed by close(CLOSE_RADIUS) as in findConeBlobs().
+    CONE_MASKS,
+};
+
+constexpr const char *OPERATION_NAMES[]{"erode", "dilate", "open", "close", "open+close"};
+
+// Random specks and rectangles in the rows and columns [margin, size - margin) of a mask.
+void fillRandomly(cv::Mat &mask, int32_t margin, std::mt19937 &rng)
+{
+    const int32_t width{mask.cols - 2 * margin};
+    const int32_t height{mask.rows - 2 * margin};
+    std::uniform_int_distribution<int32_t> percent(0, 99);
+    const int32_t density{percent(rng)};
+    for (int32_t y{0}; y < height; y++)
+    {
+        for (int32_t x{0}; x < width; x++)
+        {
+            mask.at<uint8_t>(margin + y, margin + x) = (percent(rng) < density / 4) ? 255 : 0;
+        }
+    }
+    const int32_t rectangles{std::uniform_int_distribution<int32_t>(0, 12)(rng)};
+    for (int32_t i{0}; i < rectangles; i++)
+    {
+        const int32_t x{std::uniform_int_distribution<int32_t>(0, width - 1)(rng)};
+        const int32_t y{std::uniform_int_distribution<int32_t>(0, height - 1)(rng)};
+        const int32_t w{std::uniform_int_distribution<int32_t>(1, std::min(24, width - x))(rng)};
+        const int32_t h{std::uniform_int_distribution<int32_t>(1, std::min(24, height - y))(rng)};
+        mask(cv::Rect(margin + x, margin + y, w, h)).setTo(cv::Scalar(255));
+    }
+}
+
+// Run the operation with OpenCV on the mask surrounded by black pixels, like the
+// masks of the vision loop were surrounded by the blacked-out rest of the frame.
+cv::Mat expectedResult(const cv::Mat &mask, Operation operation, uint32_t radius)
+{
+    const int32_t padding{static_cast<int32_t>(2 * CLOSE_RADIUS + 2 * radius + 1)};
+    cv::Mat canvas(mask.rows + 2 * padding, mask.cols + 2 * padding, CV_8UC1, cv::Scalar(0));
+    const cv::Rect area{padding, padding, mask.cols, mask.rows};
+    cv::Mat inside{canvas(area)};
+    mask.copyTo(inside);
+
+    const cv::Mat box{cv::getStructuringElement(cv::MORPH_RECT, cv::Size(2 * static_cast<int32_t>(radius) + 1, 2 * static_cast<int32_t>(radius) + 1))};
+    switch (operation)
+    {
+        case Operation::ERODE:
+            cv::erode(canvas, canvas, box);
+            break;
+        case Operation::DILATE:
+            cv::dilate(canvas, canvas, box);
+            break;
+        case Operation::OPEN:
+            cv::morphologyEx(canvas, canvas, cv::MORPH_OPEN, box);
+            break;
+        case Operation::CLOSE:
+            cv::morphologyEx(canvas, canvas, cv::MORPH_CLOSE, box);
+            break;
+        case Operation::CONE_MASKS:
+            cv::morphologyEx(canvas, canvas, cv::MORPH_OPEN, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(2 * MERGE_RADIUS + 1, 2 * MERGE_RADIUS + 1)));
+            cv::morphologyEx(canvas, canvas, cv::MORPH_CLOSE, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(2 * CLOSE_RADIUS + 1, 2 * CLOSE_RADIUS + 1)));
+            break;
+    }
+    return canvas(area).clone();
+}
+
+void apply(PackedMasks &masks, Operation operation, uint32_t radius)
+{
+    switch (operation)
+    {
+        case Operation::ERODE:
+            masks.erode(radius);
+            break;
+        case Operation::DILATE:
+            masks.dilate(radius);
+            break;
+        case Operation::OPEN:
+            masks.open(radius);
+            break;
+        case Operation::CLOSE:
+            masks.close(radius);
+            break;
+        case Operation::CONE_MASKS:
+            masks.open(MERGE_RADIUS);
+            masks.close(CLOSE_RADIUS);
+            break;
+    }
+}
+
+// Both planes hold different masks with a margin of the closing radius, as the
+// mask region of FrameWorkspace has around the region of interest.
+bool matchesOpenCV()
+{
+    constexpr uint32_t ITERATIONS{500};
+    constexpr uint32_t PLANES{2};
+    std::mt19937 rng{15};
+    for (uint32_t i{0}; i < ITERATIONS; i++)
+    {
+        const Operation operation{static_cast<Operation>(i % 5)};
+        const uint32_t radius{(Operation::CONE_MASKS == operation) ? CLOSE_RADIUS : std::uniform_int_distribution<uint32_t>(1, 6)(rng)};
+        const int32_t margin{static_cast<int32_t>(radius)};
+        const int32_t width{std::uniform_int_distribution<int32_t>(1, 200)(rng) + 2 * margin};
+        const int32_t height{std::uniform_int_distribution<int32_t>(1, 80)(rng) + 2 * margin};
+
+        PackedMasks masks(static_cast<uint32_t>(width), static_cast<uint32_t>(height), PLANES);
+        cv::Mat expected[PLANES];
+        for (uint32_t plane{0}; plane < PLANES; plane++)
+        {
+            cv::Mat mask(height, width, CV_8UC1, cv::Scalar(0));
+            fillRandomly(mask, margin, rng);
+            masks.pack(plane, mask.ptr<uint8_t>(0), mask.step);
+            expected[plane] = expectedResult(mask, operation, radius);
+        }
+
+        apply(masks, operation, radius);
+
+        for (uint32_t plane{0}; plane < PLANES; plane++)
+        {
+            cv::Mat result(height, width, CV_8UC1);
+            masks.unpack(plane, result.ptr<uint8_t>(0), result.step);
+            for (int32_t y{0}; y < height; y++)
+            {
+                for (int32_t x{0}; x < width; x++)
+                {
+                    if (expected[plane].at<uint8_t>(y, x) != result.at<uint8_t>(y, x))
+                    {
+                        std::cerr << OPERATION_NAMES[static_cast<int32_t>(operation)] << " with radius " << radius << " of plane " << plane << " of the "
+                                  << width << "x" << height << " masks " << i << " differs from cv::morphologyEx at (" << x << ", " << y << ")." << std::endl;
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    if (1 < argc)
+    {
+        std::cerr << argv[0] << " compares the bit-packed morphology with cv::morphologyEx." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << std::endl;
+        return retCode;
+    }
+
+    if (!matchesOpenCV())
+    {
+        std::cerr << argv[0] << ": PackedMasks differs from cv::morphologyEx." << std::endl;
+    }
+    else
+    {
+        retCode = 0;
+    }
+    return retCode;
+}
@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Regression test for the run-based blob extraction: every blob of BlobExtractor
+// must match the 8-connected component of cv::connectedComponentsWithStats with
+// the same area, bounding box and centroid, in raster order of the first pixel,
+// for whole masks and for bands of rows. BandedPerception must find the same
+// blobs in the same order as segmentCones() and findConeBlobs().
+
+#include "banded-perception.hpp"
+#include "binary-morphology.hpp"
+#include "blob-extraction.hpp"
+#include "cone-perception.hpp"
+#include "frame-workspace.hpp"
+#include "region-of-interest.hpp"
+#include "thread-pool.hpp"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Random specks and rectangles, including ones with holes and blobs inside of them.
+cv::Mat randomMask(int32_t width, int32_t height, std::mt19937 &rng)
+{
+    cv::Mat mask(height, width, CV_8UC1, cv::Scalar(0));
+    std::uniform_int_distribution<int32_t> percent(0, 99);
+    const int32_t density{percent(rng)};
+    for (int32_t y{0}; y < height; y++)
+    {
+        for (int32_t x{0}; x < width; x++)
+        {
+            mask.at<uint8_t>(y, x) = (percent(rng) < density) ? 255 : 0;
+        }
+    }
+    const int32_t rectangles{std::uniform_int_distribution<int32_t>(0, 8)(rng)};
+    for (int32_t i{0}; i < rectangles; i++)
+    {
+        const int32_t x{std::uniform_int_distribution<int32_t>(0, width - 1)(rng)};
+        const int32_t y{std::uniform_int_distribution<int32_t>(0, height - 1)(rng)};
+        const int32_t w{std::uniform_int_distribution<int32_t>(1, std::min(40, width - x))(rng)};
+        const int32_t h{std::uniform_int_distribution<int32_t>(1, std::min(40, height - y))(rng)};
+        mask(cv::Rect(x, y, w, h)).setTo(cv::Scalar((0 == (i % 3)) ? 0 : 255));
+    }
+    return mask;
+}
+
+// Compare the blobs of rows [y0, y1) of mask with the components OpenCV finds in those rows.
+bool equalsConnectedComponents(const cv::Mat &mask, int32_t y0, int32_t y1, int32_t offsetX, int32_t offsetY, const std::vector<Blob> &blobs,
+                               uint32_t iteration)
+{
+    const cv::Mat rows{mask(cv::Rect(0, y0, mask.cols, y1 - y0))};
+    cv::Mat labels;
+    cv::Mat stats;
+    cv::Mat centroids;
+    const int32_t components{cv::connectedComponentsWithStats(rows, labels, stats, centroids, 8, CV_32S)};
+
+    // The extractor orders blobs by their first pixel in raster order.
+    std::vector<int32_t> order;
+    std::vector<bool> seen(static_cast<size_t>(components), false);
+    for (int32_t y{0}; y < labels.rows; y++)
+    {
+        for (int32_t x{0}; x < labels.cols; x++)
+        {
+            const int32_t label{labels.at<int32_t>(y, x)};
+            if ((0 < label) && !seen[static_cast<size_t>(label)])
+            {
+                seen[static_cast<size_t>(label)] = true;
+                order.push_back(label);
+            }
+        }
+    }
+
+    if (order.size() != blobs.size())
+    {
+        std::cerr << "Masks " << iteration << " have " << blobs.size() << " blobs instead of " << order.size() << "." << std::endl;
+        return false;
+    }
+    for (size_t i{0}; i < blobs.size(); i++)
+    {
+        const int32_t label{order[i]};
+        const Blob &blob{blobs[i]};
+        const int32_t left{stats.at<int32_t>(label, cv::CC_STAT_LEFT) + offsetX};
+        const int32_t top{stats.at<int32_t>(label, cv::CC_STAT_TOP) + y0 + offsetY};
+        const int32_t right{left + stats.at<int32_t>(label, cv::CC_STAT_WIDTH) - 1};
+        const int32_t bottom{top + stats.at<int32_t>(label, cv::CC_STAT_HEIGHT) - 1};
+        const int32_t area{stats.at<int32_t>(label, cv::CC_STAT_AREA)};
+        // OpenCV's centroids are in the coordinates of rows; the sums are integers well below 2^53.
+        const int64_t sumX{std::llround(centroids.at<double>(label, 0) * area) + static_cast<int64_t>(offsetX) * area};
+        const int64_t sumY{std::llround(centroids.at<double>(label, 1) * area) + static_cast<int64_t>(y0 + offsetY) * area};
+        if ((static_cast<int64_t>(blob.area) != area) || (blob.left != left) || (blob.top != top) || (blob.right != right) || (blob.bottom != bottom)
+            || (static_cast<int64_t>(blob.sumX) != sumX) || (static_cast<int64_t>(blob.sumY) != sumY))
+        {
+            std::cerr << "Blob " << i << " of masks " << iteration << " has area " << blob.area << ", box (" << blob.left << ", " << blob.top << ")-("
+                      << blob.right << ", " << blob.bottom << ") and sums (" << blob.sumX << ", " << blob.sumY << ") instead of " << area << ", (" << left
+                      << ", " << top << ")-(" << right << ", " << bottom << ") and (" << sumX << ", " << sumY << ")." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool extractsLikeOpenCV()
+{
+    constexpr uint32_t ITERATIONS{500};
+    std::mt19937 rng{15};
+    std::vector<Blob> blobs;
+    for (uint32_t i{0}; i < ITERATIONS; i++)
+    {
+        const int32_t width{std::uniform_int_distribution<int32_t>(1, 200)(rng)};
+        const int32_t height{std::uniform_int_distribution<int32_t>(1, 120)(rng)};
+        const int32_t offsetX{std::uniform_int_distribution<int32_t>(0, 300)(rng)};
+        const int32_t offsetY{std::uniform_int_distribution<int32_t>(0, 300)(rng)};
+        const cv::Mat mask{randomMask(width, height, rng)};
+        PackedMasks masks(static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1);
+        masks.pack(0, mask.ptr<uint8_t>(0), mask.step);
+
+        BlobExtractor extractor(static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+        blobs.reserve(BlobExtractor::maximumBlobs(static_cast<uint32_t>(width), static_cast<uint32_t>(height)));
+        extractor.extract(masks, 0, offsetX, offsetY, blobs);
+        if (!equalsConnectedComponents(mask, 0, height, offsetX, offsetY, blobs, i))
+        {
+            return false;
+        }
+
+        // A band of rows, with an extractor sized for the band only.
+        const int32_t y0{std::uniform_int_distribution<int32_t>(0, height - 1)(rng)};
+        const int32_t y1{std::uniform_int_distribution<int32_t>(y0 + 1, height)(rng)};
+        BlobExtractor bandExtractor(static_cast<uint32_t>(width), static_cast<uint32_t>(y1 - y0));
+        bandExtractor.extract(masks, 0, static_cast<uint32_t>(y0), static_cast<uint32_t>(y1), offsetX, offsetY, blobs);
+        if (!equalsConnectedComponents(mask, y0, y1, offsetX, offsetY, blobs, i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// A frame with blue and yellow cones and specks of both colours on a grey background,
+// placed around the region of interest so that many of them cross band edges.
+cv::Mat randomFrame(int32_t width, int32_t height, const RegionOfInterest &roi, std::mt19937 &rng)
+{
+    cv::Mat frame(height, width, CV_8UC4, cv::Scalar(90, 90, 90, 255));
+    const cv::Scalar BLUE(200, 80, 20, 255);
+    const cv::Scalar YELLOW(20, 220, 230, 255);
+    const int32_t shapes{std::uniform_int_distribution<int32_t>(0, 400)(rng)};
+    for (int32_t i{0}; i < shapes; i++)
+    {
+        // Mostly specks that the opening removes or the closing merges, some cones.
+        const int32_t largest{(0 == (i % 8)) ? 60 : 8};
+        const int32_t w{std::uniform_int_distribution<int32_t>(1, largest)(rng)};
+        const int32_t h{std::uniform_int_distribution<int32_t>(1, largest)(rng)};
+        const int32_t x{std::uniform_int_distribution<int32_t>(std::max(0, roi.x - w), std::min(width - w, roi.x + roi.width))(rng)};
+        const int32_t y{std::uniform_int_distribution<int32_t>(std::max(0, roi.y - h), std::min(height - h, roi.y + roi.height))(rng)};
+        frame(cv::Rect(x, y, w, h)).setTo((0 == (i % 2)) ? BLUE : YELLOW);
+    }
+    return frame;
+}
+
+bool equalBlobs(const std::vector<Blob> &expected, const std::vector<Blob> &blobs, const char *colour, uint32_t bands, uint32_t iteration)
+{
+    bool equal{expected.size() == blobs.size()};
+    for (size_t i{0}; equal && (i < blobs.size()); i++)
+    {
+        const Blob &a{expected[i]};
+        const Blob &b{blobs[i]};
+        equal = (a.area == b.area) && (a.sumX == b.sumX) && (a.sumY == b.sumY) && (a.left == b.left) && (a.top == b.top) && (a.right == b.right)
+                && (a.bottom == b.bottom);
+    }
+    if (!equal)
+    {
+        std::cerr << "The " << colour << " blobs of frame " << iteration << " in " << bands << " bands differ from findConeBlobs()." << std::endl;
+    }
+    return equal;
+}
+
+bool bandedEqualsWholeFrame()
+{
+    constexpr uint32_t ITERATIONS{100};
+    constexpr int32_t WIDTH{640};
+    constexpr int32_t HEIGHT{480};
+    const RegionOfInterest roi{clipRegionOfInterest(CONE_REGION_OF_INTEREST, WIDTH, HEIGHT)};
+    const RegionOfInterest maskRegion{FrameWorkspace::maskRegionFor(WIDTH, HEIGHT, roi)};
+    const ConeColourThresholds thresholds{};
+    const ConeColourClassifier classifier{6, thresholds};
+
+    std::mt19937 rng{15};
+    FrameWorkspace expected{WIDTH, HEIGHT, roi};
+    FrameWorkspace ws{WIDTH, HEIGHT, roi};
+    for (uint32_t i{0}; i < ITERATIONS; i++)
+    {
+        const uint32_t bands{std::uniform_int_distribution<uint32_t>(2, 16)(rng)};
+        const ConeColourClassifier *withClassifier{(0 == (i % 2)) ? nullptr : &classifier};
+        const cv::Mat frame{randomFrame(WIDTH, HEIGHT, roi, rng)};
+
+        segmentCones(frame, roi, thresholds, withClassifier, expected);
+        findConeBlobs(expected);
+
+        ThreadPool pool{i % 4};
+        BandedPerception banded{pool, bands, maskRegion};
+        banded.segment(frame, roi, thresholds, withClassifier, ws);
+        banded.findBlobs(ws);
+
+        if (!equalBlobs(expected.blueBlobs, ws.blueBlobs, "blue", bands, i) || !equalBlobs(expected.yellowBlobs, ws.yellowBlobs, "yellow", bands, i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    if (1 < argc)
+    {
+        std::cerr << argv[0] << " compares the run-based blob extraction with cv::connectedComponentsWithStats and the banded perception with the whole frame." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << std::endl;
+        return retCode;
+    }
+
+    if (!extractsLikeOpenCV())
+    {
+        std::cerr << argv[0] << ": BlobExtractor differs from cv::connectedComponentsWithStats." << std::endl;
+    }
+    else if (!bandedEqualsWholeFrame())
+    {
+        std::cerr << argv[0] << ": BandedPerception differs from findConeBlobs." << std::endl;
+    }
+    else
+    {
+        retCode = 0;
+    }
+    return retCode;
+}
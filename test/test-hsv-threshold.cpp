@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Regression test for the fused HSV kernel: bgraToHsv() must match
+// cv::cvtColor(COLOR_BGR2HSV) for every 24-bit colour, and thresholdCones() must
+// match cvtColor followed by cv::inRange on random frames, thresholds and regions.
+
+#include "hsv-threshold.hpp"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+namespace
+{
+// Compare bgraToHsv() with cvtColor on an image holding all 2^24 colours.
+bool convertsEveryColourLikeOpenCV()
+{
+    cv::Mat bgr(4096, 4096, CV_8UC3);
+    for (int32_t y{0}; y < bgr.rows; y++)
+    {
+        uint8_t *row{bgr.ptr<uint8_t>(y)};
+        for (int32_t x{0}; x < bgr.cols; x++)
+        {
+            const uint32_t colour{static_cast<uint32_t>(y) * 4096 + static_cast<uint32_t>(x)};
+            row[3 * x + 0] = static_cast<uint8_t>(colour);
+            row[3 * x + 1] = static_cast<uint8_t>(colour >> 8);
+            row[3 * x + 2] = static_cast<uint8_t>(colour >> 16);
+        }
+    }
+    cv::Mat expected;
+    cv::cvtColor(bgr, expected, cv::COLOR_BGR2HSV);
+
+    for (int32_t y{0}; y < bgr.rows; y++)
+    {
+        const uint8_t *in{bgr.ptr<uint8_t>(y)};
+        const uint8_t *out{expected.ptr<uint8_t>(y)};
+        for (int32_t x{0}; x < bgr.cols; x++)
+        {
+            const uint8_t bgra[4]{in[3 * x + 0], in[3 * x + 1], in[3 * x + 2], 255};
+            uint8_t h{0};
+            uint8_t s{0};
+            uint8_t v{0};
+            bgraToHsv(bgra, h, s, v);
+            if ((out[3 * x + 0] != h) || (out[3 * x + 1] != s) || (out[3 * x + 2] != v))
+            {
+                std::cerr << "BGR (" << +bgra[0] << ", " << +bgra[1] << ", " << +bgra[2] << ") gives HSV (" << +h << ", " << +s << ", " << +v
+                          << ") instead of (" << +out[3 * x + 0] << ", " << +out[3 * x + 1] << ", " << +out[3 * x + 2] << ")." << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+HsvRange randomRange(std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int32_t> hue(0, 179);
+    std::uniform_int_distribution<int32_t> byte(0, 255);
+    int32_t h[2]{hue(rng), hue(rng)};
+    int32_t s[2]{byte(rng), byte(rng)};
+    int32_t v[2]{byte(rng), byte(rng)};
+    if (h[0] > h[1])
+    {
+        std::swap(h[0], h[1]);
+    }
+    if (s[0] > s[1])
+    {
+        std::swap(s[0], s[1]);
+    }
+    if (v[0] > v[1])
+    {
+        std::swap(v[0], v[1]);
+    }
+    return HsvRange{static_cast<uint8_t>(h[0]), static_cast<uint8_t>(s[0]), static_cast<uint8_t>(v[0]),
+                    static_cast<uint8_t>(h[1]), static_cast<uint8_t>(s[1]), static_cast<uint8_t>(v[1])};
+}
+
+cv::Mat inRange(const cv::Mat &hsv, const HsvRange &range)
+{
+    cv::Mat mask;
+    cv::inRange(hsv, cv::Scalar(range.lowerH, range.lowerS, range.lowerV), cv::Scalar(range.upperH, range.upperS, range.upperV), mask);
+    return mask;
+}
+
+bool equalMasks(const cv::Mat &expected, const cv::Mat &mask, const char *colour, uint32_t iteration)
+{
+    for (int32_t y{0}; y < expected.rows; y++)
+    {
+        for (int32_t x{0}; x < expected.cols; x++)
+        {
+            if (expected.at<uint8_t>(y, x) != mask.at<uint8_t>(y, x))
+            {
+                std::cerr << "The " << colour << " mask of frame " << iteration << " differs from cv::inRange at (" << x << ", " << y << ")." << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Compare thresholdCones() with cvtColor + inRange on regions of random BGRA frames;
+// odd widths and offsets exercise the scalar tail of the vectorised path.
+bool thresholdsLikeOpenCV()
+{
+    constexpr uint32_t ITERATIONS{200};
+    std::mt19937 rng{15};
+    std::uniform_int_distribution<int32_t> size(1, 160);
+    for (uint32_t i{0}; i < ITERATIONS; i++)
+    {
+        const int32_t width{size(rng)};
+        const int32_t height{size(rng)};
+        cv::Mat frame(height + 4, width + 9, CV_8UC4);
+        cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(256));
+        const cv::Rect region{std::uniform_int_distribution<int32_t>(0, 9)(rng), std::uniform_int_distribution<int32_t>(0, 4)(rng), width, height};
+        const cv::Mat roi{frame(region)};
+
+        ConeColourThresholds thresholds{};
+        if (0 != (i % 4))
+        {
+            thresholds.blue = randomRange(rng);
+            thresholds.yellow = randomRange(rng);
+        }
+
+        cv::Mat hsv;
+        cv::cvtColor(roi, hsv, cv::COLOR_BGR2HSV);
+        const cv::Mat expectedBlue{inRange(hsv, thresholds.blue)};
+        const cv::Mat expectedYellow{inRange(hsv, thresholds.yellow)};
+
+        cv::Mat blue(height, width + 3, CV_8UC1, cv::Scalar(7));
+        cv::Mat yellow(height, width + 3, CV_8UC1, cv::Scalar(7));
+        thresholdCones(roi.ptr<uint8_t>(0), roi.step, static_cast<uint32_t>(width), static_cast<uint32_t>(height), thresholds, blue.ptr<uint8_t>(0),
+                       yellow.ptr<uint8_t>(0), blue.step);
+
+        if (!equalMasks(expectedBlue, blue(cv::Rect(0, 0, width, height)), "blue", i)
+            || !equalMasks(expectedYellow, yellow(cv::Rect(0, 0, width, height)), "yellow", i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    if (1 < argc)
+    {
+        std::cerr << argv[0] << " compares the fused HSV kernel with cv::cvtColor and cv::inRange." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << std::endl;
+        return retCode;
+    }
+
+    if (!convertsEveryColourLikeOpenCV())
+    {
+        std::cerr << argv[0] << ": bgraToHsv differs from cv::cvtColor." << std::endl;
+    }
+    else if (!thresholdsLikeOpenCV())
+    {
+        std::cerr << argv[0] << ": thresholdCones differs from cv::cvtColor and cv::inRange." << std::endl;
+    }
+    else
+    {
+        retCode = 0;
+    }
+    return retCode;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Regression test for the Proto coders generated by cluon-msc: encode() must write
+// the same bytes as cluon::ToProtoVisitor, decode() must read the same values as
+// cluon::FromProtoVisitor, and encodedSize() and MaxEncodedSize() must bound the
+// output, for random messages with every field type and for the messages of the
+// OpenDLV Standard Message Set the vision loop exchanges.
+
+#include "cluon-complete.hpp"
+#include "opendlv-standard-message-set.hpp"
+#include "test-messages.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace
+{
+static_assert(test::Nested::MaxEncodedSize() == (1 + 5) + (1 + 4), "Nested has a varint and a float field");
+static_assert(test::Empty::MaxEncodedSize() == 0, "Empty has no fields");
+static_assert(test::Numbers::MaxEncodedSize() != PROTO_UNBOUNDED_SIZE, "Numbers has an upper bound, also with an Empty field");
+static_assert(test::Strings::MaxEncodedSize() == PROTO_UNBOUNDED_SIZE, "Strings has no upper bound");
+
+template <typename T>
+std::string visitorEncode(T &message)
+{
+    cluon::ToProtoVisitor encoder;
+    message.accept(encoder);
+    return encoder.encodedData();
+}
+
+template <typename T>
+T visitorDecode(const std::string &data)
+{
+    std::stringstream sstr{data};
+    cluon::FromProtoVisitor decoder;
+    decoder.decodeFrom(sstr);
+    T message;
+    message.accept(decoder);
+    return message;
+}
+
+// Encode with both coders and decode the bytes with both; the decoded messages are
+// compared through their encoding, which also covers NaN and negative zero.
+template <typename T>
+bool codersAgree(T &message, const char *name, uint32_t iteration)
+{
+    const std::string expected{visitorEncode(message)};
+    std::string encoded(message.encodedSize(), '\0');
+    const size_t written{message.encode(&encoded[0])};
+    const size_t maximum{T::MaxEncodedSize()};
+    if ((written != encoded.size()) || (expected != encoded) || (maximum < written))
+    {
+        std::cerr << name << " " << iteration << " is encoded into " << written << " of " << encoded.size() << " bytes (at most " << maximum
+                  << ") that differ from the " << expected.size() << " bytes of cluon::ToProtoVisitor." << std::endl;
+        return false;
+    }
+
+    T decoded;
+    T visitorDecoded{visitorDecode<T>(expected)};
+    if (!decoded.decode(expected.data(), expected.size()) || (visitorEncode(decoded) != expected) || (visitorEncode(visitorDecoded) != expected))
+    {
+        std::cerr << name << " " << iteration << " is not decoded like with cluon::FromProtoVisitor." << std::endl;
+        return false;
+    }
+
+    cluon::data::Envelope envelope;
+    envelope.dataType(T::ID());
+    envelope.serializedData(expected);
+    T extracted{cluon::extractMessage<T>(std::move(envelope))};
+    if (visitorEncode(extracted) != expected)
+    {
+        std::cerr << name << " " << iteration << " is not extracted from an Envelope like it was encoded." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template <typename I>
+I randomInteger(std::mt19937_64 &rng)
+{
+    // Shift to hit every length of varints, not only the longest.
+    return static_cast<I>(rng() >> (rng() % 64));
+}
+
+float randomFloat(std::mt19937_64 &rng)
+{
+    return static_cast<float>(static_cast<int32_t>(rng())) / 7.0f;
+}
+
+std::string randomString(std::mt19937_64 &rng, size_t longest)
+{
+    std::string s(static_cast<size_t>(rng() % (longest + 1)), '\0');
+    for (char &c : s)
+    {
+        c = static_cast<char>(rng());
+    }
+    return s;
+}
+
+bool randomMessagesAgree()
+{
+    constexpr uint32_t ITERATIONS{20000};
+    std::mt19937_64 rng{15};
+    for (uint32_t i{0}; i < ITERATIONS; i++)
+    {
+        test::Nested nested;
+        nested.a(randomInteger<int32_t>(rng)).b(randomFloat(rng));
+
+        test::Numbers numbers;
+        numbers.b(0 != (rng() & 1))
+            .c(randomInteger<char>(rng))
+            .u8(randomInteger<uint8_t>(rng))
+            .i8(randomInteger<int8_t>(rng))
+            .u16(randomInteger<uint16_t>(rng))
+            .i16(randomInteger<int16_t>(rng))
+            .u32(randomInteger<uint32_t>(rng))
+            .i32(randomInteger<int32_t>(rng))
+            .u64(randomInteger<uint64_t>(rng))
+            .i64(randomInteger<int64_t>(rng))
+            .f(randomFloat(rng))
+            .d(static_cast<double>(static_cast<int64_t>(rng())) / 3.0)
+            .nested(nested);
+
+        test::Strings strings;
+        strings.s(randomString(rng, 300)).by(randomString(rng, 3)).nested(nested);
+
+        opendlv::proxy::GroundSteeringRequest steering;
+        steering.groundSteering(randomFloat(rng));
+        opendlv::proxy::AngularVelocityReading angularVelocity;
+        angularVelocity.angularVelocityX(randomFloat(rng)).angularVelocityY(randomFloat(rng)).angularVelocityZ(randomFloat(rng));
+        opendlv::proxy::ImageReading image;
+        image.fourcc(randomString(rng, 4)).width(randomInteger<uint32_t>(rng)).height(randomInteger<uint32_t>(rng)).data(randomString(rng, 2000));
+
+        test::Empty empty;
+
+        if (!codersAgree(nested, "Nested", i) || !codersAgree(empty, "Empty", i) || !codersAgree(numbers, "Numbers", i) || !codersAgree(strings, "Strings", i)
+            || !codersAgree(steering, "GroundSteeringRequest", i) || !codersAgree(angularVelocity, "AngularVelocityReading", i)
+            || !codersAgree(image, "ImageReading", i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// decode() rejects truncated bytes and skips fields it does not know.
+bool malformedBytesAreHandled()
+{
+    test::Numbers numbers;
+    numbers.i32(-5).d(2.5);
+    const std::string data{visitorEncode(numbers)};
+    test::Numbers truncated;
+    if (truncated.decode(data.data(), data.size() - 1))
+    {
+        std::cerr << "Truncated bytes are decoded without an error." << std::endl;
+        return false;
+    }
+
+    // Nested only knows the field identifiers 1 and 2.
+    test::Nested nested;
+    test::Numbers unknown;
+    unknown.u8(7).i64(-9).d(2.5);
+    const std::string unknownFields{visitorEncode(unknown)};
+    if (!nested.decode(unknownFields.data(), unknownFields.size()) || (0 != nested.a()))
+    {
+        std::cerr << "Unknown fields are not skipped." << std::endl;
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    if (1 < argc)
+    {
+        std::cerr << argv[0] << " compares the Proto coders generated by cluon-msc with cluon::ToProtoVisitor and cluon::FromProtoVisitor." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << std::endl;
+        return retCode;
+    }
+
+    if (!randomMessagesAgree() || !malformedBytesAreHandled())
+    {
+        std::cerr << argv[0] << ": The generated Proto coders differ from the visitors." << std::endl;
+    }
+    else
+    {
+        retCode = 0;
+    }
+    return retCode;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Regression test for SeqLock: readers running concurrently with the writer must
+// only ever see values that were stored as a whole, in the order they were stored.
+
+#include "seqlock.hpp"
+#include "yaw-rate-state.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Several words that are only consistent if they come from the same store().
+struct Words
+{
+    uint64_t sequence;
+    uint64_t inverted;
+    uint64_t tripled;
+    uint64_t mixed;
+    uint32_t low;
+};
+
+Words wordsFor(uint64_t sequence) noexcept
+{
+    return Words{sequence, ~sequence, 3 * sequence, sequence ^ 0x9e3779b97f4a7c15ULL, static_cast<uint32_t>(sequence)};
+}
+
+bool consistent(const Words &words) noexcept
+{
+    const Words expected{wordsFor(words.sequence)};
+    return (expected.inverted == words.inverted) && (expected.tripled == words.tripled) && (expected.mixed == words.mixed) && (expected.low == words.low);
+}
+
+bool storesAndLoads()
+{
+    const YawRateState state{0.25, -1.5, 1234567};
+    YawRateCell cell;
+    if (1 != cell.version())
+    {
+        std::cerr << "A new SeqLock has version " << cell.version() << " instead of 1." << std::endl;
+        return false;
+    }
+    cell.store(state);
+    const YawRateState loaded{cell.load()};
+    if ((2 != cell.version()) || (0 != std::memcmp(&state, &loaded, sizeof(YawRateState))))
+    {
+        std::cerr << "A SeqLock does not return the value stored last." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// One writer stores increasing sequences while the readers check every value they load;
+// it keeps storing until the readers have loaded often enough, even on a single core.
+bool readersSeeWholeStores()
+{
+    constexpr uint64_t STORES{2000000};
+    constexpr uint64_t LOADS{2000000};
+    const uint32_t READERS{std::max(2u, std::thread::hardware_concurrency()) - 1};
+    SeqLock<Words> cell{wordsFor(0)};
+    std::atomic<bool> writing{true};
+    std::atomic<uint64_t> loads{0};
+    std::atomic<uint64_t> tornReads{0};
+    std::atomic<uint64_t> reorderedReads{0};
+
+    std::vector<std::thread> readers;
+    for (uint32_t i{0}; i < READERS; i++)
+    {
+        readers.emplace_back([&cell, &writing, &loads, &tornReads, &reorderedReads]() {
+            uint64_t last{0};
+            while (writing.load(std::memory_order_relaxed))
+            {
+                const Words words{cell.load()};
+                if (!consistent(words))
+                {
+                    tornReads++;
+                }
+                if (words.sequence < last)
+                {
+                    reorderedReads++;
+                }
+                last = words.sequence;
+                loads++;
+            }
+        });
+    }
+    uint64_t stores{0};
+    while ((stores < STORES) || (loads.load(std::memory_order_relaxed) < LOADS))
+    {
+        stores++;
+        cell.store(wordsFor(stores));
+    }
+    writing.store(false);
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    const Words last{cell.load()};
+    if ((0 != tornReads) || (0 != reorderedReads) || (stores != last.sequence) || (stores + 1 != cell.version()))
+    {
+        std::cerr << READERS << " readers saw " << tornReads << " torn and " << reorderedReads << " reordered values; the last value is " << last.sequence
+                  << " at version " << cell.version() << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    if (1 < argc)
+    {
+        std::cerr << argv[0] << " checks that SeqLock readers only see whole values while the writer stores." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << std::endl;
+        return retCode;
+    }
+
+    if (!storesAndLoads() || !readersSeeWholeStores())
+    {
+        std::cerr << argv[0] << ": SeqLock returned an inconsistent value." << std::endl;
+    }
+    else
+    {
+        retCode = 0;
+    }
+    return retCode;
+}
@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Regression test for the steering model: the breakpoint tables and
+// steeringAlgorithm()/checkSteering() must return bit for bit what the original
+// if/else ladders returned, for exact threshold hits, their neighbours, random
+// yaw rates and NaN; the batch overloads must match the scalar ones.
+
+#include "steering-algorithm.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+// The positive ladder of the original steeringAlgorithm, after the offset was added.
+double originalPositiveLadder(double steeringAngle)
+{
+    if (steeringAngle >= 0.23)
+    {
+        steeringAngle = 0.23;
+    }
+    else if (steeringAngle >= 0.19)
+    {
+        steeringAngle = 0.22;
+    }
+    else if (steeringAngle >= 0.18)
+    {
+        steeringAngle = 0.19;
+    }
+    else if (steeringAngle >= 0.16)
+    {
+        steeringAngle = 0.17;
+    }
+    else if (steeringAngle >= 0.12)
+    {
+        steeringAngle = 0.086;
+    }
+    else if (steeringAngle >= 0.07)
+    {
+        steeringAngle = 0.07;
+    }
+    else if (steeringAngle >= 0.05)
+    {
+        steeringAngle = 0.06;
+    }
+    else if (steeringAngle >= 0.02)
+    {
+        steeringAngle = 0.03;
+    }
+    return steeringAngle;
+}
+
+// The negative ladder of the original steeringAlgorithm, after the offset was subtracted.
+double originalNegativeLadder(double steeringAngle)
+{
+    if (steeringAngle <= -0.23)
+    {
+        steeringAngle = -0.26;
+    }
+    else if (steeringAngle <= -0.19)
+    {
+        steeringAngle = -0.23;
+    }
+    else if (steeringAngle <= -0.18)
+    {
+        steeringAngle = -0.222;
+    }
+    else if (steeringAngle <= -0.16)
+    {
+        steeringAngle = -0.209;
+    }
+    else if (steeringAngle <= -0.12)
+    {
+        steeringAngle = -0.17;
+    }
+    else if (steeringAngle <= -0.07)
+    {
+        steeringAngle = -0.11;
+    }
+    return steeringAngle;
+}
+
+// The original steeringAlgorithm with its constants.
+double originalSteeringAlgorithm(int32_t direction, double angularVeloZ, double angularVeloZDerivative)
+{
+    double steeringAngle{(angularVeloZ * 0.002879) + (angularVeloZDerivative * 0.00097)};
+    if (steeringAngle >= 0)
+    {
+        steeringAngle = originalPositiveLadder(steeringAngle + 0.04);
+    }
+    else if (direction == 1)
+    {
+        steeringAngle = 0;
+    }
+    else
+    {
+        steeringAngle = (angularVeloZ * 0.001879) + (angularVeloZDerivative * 0.00091);
+        steeringAngle = originalNegativeLadder(steeringAngle - 0.04);
+    }
+    return steeringAngle;
+}
+
+double originalCheckSteering(bool leftCone, bool rightCone, double angularVeloZ, double angularVeloZDerivative)
+{
+    double steering{0};
+    if (leftCone && rightCone)
+    {
+        steering = originalSteeringAlgorithm(1, angularVeloZ, angularVeloZDerivative);
+    }
+    else if (!leftCone && rightCone)
+    {
+        steering = originalSteeringAlgorithm(0, angularVeloZ, angularVeloZDerivative);
+    }
+    else if (!rightCone && leftCone)
+    {
+        steering = originalSteeringAlgorithm(2, angularVeloZ, angularVeloZDerivative);
+    }
+    return steering;
+}
+
+// Bitwise equality, so that NaN equals NaN and 0.0 differs from -0.0.
+bool sameBits(double a, double b) noexcept
+{
+    return 0 == std::memcmp(&a, &b, sizeof(double));
+}
+
+// A yaw rate or derivative: mostly moderate values, sometimes large, zero or NaN.
+double randomInput(std::mt19937_64 &rng)
+{
+    switch (rng() % 16)
+    {
+        case 0:
+            return std::numeric_limits<double>::quiet_NaN();
+        case 1:
+            return 0.0;
+        case 2:
+            return std::uniform_real_distribution<double>(-2000.0, 2000.0)(rng);
+        default:
+            return std::uniform_real_distribution<double>(-120.0, 120.0)(rng);
+    }
+}
+
+bool laddersMatch()
+{
+    std::vector<double> values{0.0, -0.0, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(),
+                               -std::numeric_limits<double>::infinity()};
+    // Every threshold and the values right next to it.
+    for (double threshold : POSITIVE_STEERING_BREAKPOINTS.thresholds)
+    {
+        values.insert(values.end(), {threshold, std::nextafter(threshold, 1.0), std::nextafter(threshold, -1.0)});
+    }
+    for (double threshold : NEGATIVE_STEERING_BREAKPOINTS.thresholds)
+    {
+        values.insert(values.end(), {threshold, std::nextafter(threshold, 1.0), std::nextafter(threshold, -1.0)});
+    }
+    std::mt19937_64 rng{15};
+    for (uint32_t i{0}; i < 100000; i++)
+    {
+        values.push_back(std::uniform_real_distribution<double>(-0.4, 0.4)(rng));
+    }
+
+    for (double x : values)
+    {
+        if (!sameBits(originalPositiveLadder(x), mapAtLeast(POSITIVE_STEERING_BREAKPOINTS, x)) ||
+            !sameBits(originalNegativeLadder(x), mapAtMost(NEGATIVE_STEERING_BREAKPOINTS, x)))
+        {
+            std::cerr << "The breakpoint tables map " << x << " to " << mapAtLeast(POSITIVE_STEERING_BREAKPOINTS, x) << " and "
+                      << mapAtMost(NEGATIVE_STEERING_BREAKPOINTS, x) << " instead of " << originalPositiveLadder(x) << " and " << originalNegativeLadder(x) << "."
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool steeringMatches()
+{
+    constexpr uint32_t SAMPLES{2000000};
+    std::mt19937_64 rng{15};
+    for (uint32_t i{0}; i < SAMPLES; i++)
+    {
+        const int32_t direction{static_cast<int32_t>(rng() % 3)};
+        const bool leftCone{0 != (rng() & 1)};
+        const bool rightCone{0 != (rng() & 1)};
+        const double angularVeloZ{randomInput(rng)};
+        const double angularVeloZDerivative{randomInput(rng)};
+        const double expected{originalSteeringAlgorithm(direction, angularVeloZ, angularVeloZDerivative)};
+        const double steering{steeringAlgorithm(direction, angularVeloZ, angularVeloZDerivative)};
+        const double expectedForCones{originalCheckSteering(leftCone, rightCone, angularVeloZ, angularVeloZDerivative)};
+        const double steeringForCones{checkSteering(leftCone, rightCone, angularVeloZ, angularVeloZDerivative)};
+        if (!sameBits(expected, steering) || !sameBits(expectedForCones, steeringForCones))
+        {
+            std::cerr << "Direction " << direction << ", cones " << leftCone << "/" << rightCone << ", yaw rate " << angularVeloZ << " and derivative "
+                      << angularVeloZDerivative << " steer " << steering << " and " << steeringForCones << " instead of " << expected << " and "
+                      << expectedForCones << "." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// The batch overloads (AVX2 where available) against the scalar ones, for every
+// count up to a few vectors, unaligned starts and cone flags other than 0 and 1.
+bool batchesMatch()
+{
+    constexpr size_t MAX_COUNT{37};
+    constexpr uint8_t FLAGS[]{0, 1, 2, 255};
+    constexpr int32_t DIRECTIONS[]{0, 1, 2, -1, 255};
+    std::mt19937_64 rng{15};
+    for (uint32_t round{0}; round < 2000; round++)
+    {
+        for (size_t count{0}; count <= MAX_COUNT; count++)
+        {
+            const size_t start{round % 3};
+            std::vector<int32_t> direction(start + count);
+            std::vector<uint8_t> leftCone(start + count);
+            std::vector<uint8_t> rightCone(start + count);
+            std::vector<double> angularVeloZ(start + count);
+            std::vector<double> angularVeloZDerivative(start + count);
+            for (size_t i{start}; i < start + count; i++)
+            {
+                direction[i] = DIRECTIONS[rng() % 5];
+                leftCone[i] = FLAGS[rng() % 4];
+                rightCone[i] = FLAGS[rng() % 4];
+                angularVeloZ[i] = randomInput(rng);
+                angularVeloZDerivative[i] = randomInput(rng);
+            }
+
+            std::vector<double> steering(count + 1, -1.0);
+            steeringAlgorithm(direction.data() + start, angularVeloZ.data() + start, angularVeloZDerivative.data() + start, steering.data(), count);
+            std::vector<double> steeringForCones(count + 1, -1.0);
+            const SteeringBatch batch{leftCone.data() + start, rightCone.data() + start, angularVeloZ.data() + start,
+                                      angularVeloZDerivative.data() + start, count};
+            checkSteering(batch, steeringForCones.data());
+
+            for (size_t i{0}; i < count; i++)
+            {
+                const size_t j{start + i};
+                const double expected{steeringAlgorithm(direction[j], angularVeloZ[j], angularVeloZDerivative[j])};
+                const double expectedForCones{checkSteering(0 != leftCone[j], 0 != rightCone[j], angularVeloZ[j], angularVeloZDerivative[j])};
+                if (!sameBits(expected, steering[i]) || !sameBits(expectedForCones, steeringForCones[i]))
+                {
+                    std::cerr << "Frame " << i << " of " << count << " (direction " << direction[j] << ", cone flags " << +leftCone[j] << "/"
+                              << +rightCone[j] << ", yaw rate " << angularVeloZ[j] << ", derivative " << angularVeloZDerivative[j] << ") steers "
+                              << steering[i] << " and " << steeringForCones[i] << " in a batch instead of " << expected << " and " << expectedForCones
+                              << "." << std::endl;
+                    return false;
+                }
+            }
+            if (!sameBits(-1.0, steering[count]) || !sameBits(-1.0, steeringForCones[count]))
+            {
+                std::cerr << "A batch of " << count << " frames wrote past its end." << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    if (1 < argc)
+    {
+        std::cerr << argv[0] << " compares the table-driven steering with the original if/else ladders and its batch overloads with the scalar ones." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << std::endl;
+        return retCode;
+    }
+
+    if (!laddersMatch() || !steeringMatches() || !batchesMatch())
+    {
+        std::cerr << argv[0] << ": The steering differs from its reference." << std::endl;
+    }
+    else
+    {
+        retCode = 0;
+    }
+    return retCode;
+}
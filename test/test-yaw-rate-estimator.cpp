@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2024  Group 15
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Regression test for YawRateEstimator: the Savitzky-Golay running sums must agree
+// with a least-squares line fitted directly to the window, readings whose time stamp
+// does not advance count as nominalPeriod apart, and the default filter keeps the
+// original per-reading difference.
+
+#include "yaw-rate-estimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <random>
+
+namespace
+{
+struct Reading
+{
+    double time;
+    double value;
+};
+
+// Fit a line through the readings around their mean time and evaluate it at the newest one.
+YawRateState fitDirectly(const std::deque<Reading> &readings, double nominalPeriod)
+{
+    double meanT{0.0};
+    double meanV{0.0};
+    for (const Reading &r : readings)
+    {
+        meanT += r.time;
+        meanV += r.value;
+    }
+    meanT /= static_cast<double>(readings.size());
+    meanV /= static_cast<double>(readings.size());
+
+    double sxx{0.0};
+    double sxy{0.0};
+    for (const Reading &r : readings)
+    {
+        sxx += (r.time - meanT) * (r.time - meanT);
+        sxy += (r.time - meanT) * (r.value - meanV);
+    }
+    const double slope{(1 < readings.size()) && (0.0 < sxx) ? sxy / sxx : 0.0};
+    return YawRateState{meanV + slope * (readings.back().time - meanT), slope * nominalPeriod, 0};
+}
+
+bool savitzkyGolayMatchesDirectFit()
+{
+    constexpr double TOLERANCE{1e-7};
+    std::mt19937_64 rng{15};
+    for (uint32_t window{2}; window <= YawRateEstimator::MAXIMUM_WINDOW; window++)
+    {
+        YawRateFilterSettings settings;
+        settings.filter = YawRateFilter::SavitzkyGolay;
+        settings.window = window;
+        YawRateEstimator estimator{settings};
+
+        std::deque<Reading> readings;
+        int64_t sampleTimeStamp{1584542901000000};
+        double time{0.0};
+        double yawRate{0.0};
+        for (uint32_t i{0}; i < 20000; i++)
+        {
+            // Mostly ~16 Hz with jitter, sometimes a repeated or earlier time stamp.
+            const uint64_t kind{rng() % 20};
+            const int64_t step{(0 == kind) ? 0 : ((1 == kind) ? -5000 : std::uniform_int_distribution<int64_t>(30000, 90000)(rng))};
+            sampleTimeStamp += step;
+            time += ((0 == i) || (0 >= step)) ? settings.nominalPeriod : static_cast<double>(step) * 1e-6;
+            yawRate = std::max(-3.0, std::min(3.0, yawRate + std::normal_distribution<double>(0.0, 0.2)(rng)));
+
+            readings.push_back(Reading{time, yawRate});
+            if (window < readings.size())
+            {
+                readings.pop_front();
+            }
+            const YawRateState expected{fitDirectly(readings, settings.nominalPeriod)};
+            const YawRateState estimate{estimator.update(yawRate, sampleTimeStamp)};
+            if ((TOLERANCE < std::fabs(expected.value - estimate.value)) || (TOLERANCE < std::fabs(expected.derivative - estimate.derivative)))
+            {
+                std::cerr << "Reading " << i << " with a window of " << window << " estimates " << estimate.value << " and " << estimate.derivative
+                          << " instead of " << expected.value << " and " << expected.derivative << "." << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool check(const char *what, double expected, double actual)
+{
+    if (1e-12 < std::fabs(expected - actual))
+    {
+        std::cerr << what << " is " << actual << " instead of " << expected << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool stalledTimeStampsUseNominalPeriod()
+{
+    YawRateFilterSettings settings;
+    settings.filter = YawRateFilter::Difference;
+    const int64_t period{static_cast<int64_t>(settings.nominalPeriod * 2e6)};
+    YawRateEstimator estimator{settings};
+    bool ok{check("The first derivative", 0.0, estimator.update(1.0, 1000000).derivative)};
+    // Equal and earlier time stamps are taken to be nominalPeriod apart.
+    ok = ok && check("The derivative over a repeated time stamp", 0.5, estimator.update(1.5, 1000000).derivative);
+    ok = ok && check("The derivative over an earlier time stamp", -0.25, estimator.update(1.25, 900000).derivative);
+    // Over two nominal periods the derivative per nominal period halves.
+    ok = ok && check("The derivative over two periods", 0.5, estimator.update(2.25, 900000 + period).derivative);
+    return ok;
+}
+
+bool defaultKeepsOriginalDifference()
+{
+    YawRateEstimator estimator;
+    bool ok{YawRateFilter::Sample == estimator.settings().filter};
+    // The previous reading starts out as 0 and time stamps do not matter.
+    ok = ok && check("The first sample derivative", 1.0, estimator.update(1.0, 1000000).derivative);
+    ok = ok && check("The sample derivative", 0.5, estimator.update(1.5, 5000000).derivative);
+    ok = ok && check("The sample derivative over a repeated time stamp", -2.0, estimator.update(-0.5, 5000000).derivative);
+    if (!ok)
+    {
+        std::cerr << "The default yaw-rate filter is not the original per-reading difference." << std::endl;
+    }
+    return ok;
+}
+} // namespace
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    if (1 < argc)
+    {
+        std::cerr << argv[0] << " checks the yaw-rate filters against a direct least-squares fit and their handling of time stamps." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << std::endl;
+        return retCode;
+    }
+
+    if (!savitzkyGolayMatchesDirectFit() || !stalledTimeStampsUseNominalPeriod() || !defaultKeepsOriginalDifference())
+    {
+        std::cerr << argv[0] << ": The yaw-rate estimator differs from its reference." << std::endl;
+    }
+    else
+    {
+        retCode = 0;
+    }
+    return retCode;
+}